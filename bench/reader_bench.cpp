@@ -0,0 +1,166 @@
+// Cost of turning an eth_getBlockByNumber response with full transactions
+// into a Block: parsing a DOM and converting it with from_json, as
+// callMethod does, against response::read(), which fills the Block from
+// the SAX events directly.
+//
+//   reader_bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "types/response.h"
+#include "types/response_reader.h"
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+using web3::type::response::Block;
+
+namespace
+{
+
+// Hex string of the given byte count whose digits depend on seed, so no
+// two fields share their text.
+std::string hex(size_t bytes, int seed)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out = "0x";
+    for (size_t i = 0; i < 2 * bytes; i++)
+        out += digits[(seed * 31 + i * 7) & 15];
+    return out;
+}
+
+// A London-era type 2 transfer with an access list, as mainnet nodes
+// return it. Every seventh one also carries blob hashes.
+json transaction(int i)
+{
+    json tx = {{"blockHash", hex(32, 1)},
+               {"blockNumber", "0x12a05f2"},
+               {"hash", hex(32, i + 7)},
+               {"from", hex(20, i)},
+               {"to", hex(20, i + 1)},
+               {"transactionIndex", "0x" + std::to_string(i)},
+               {"type", "0x2"},
+               {"nonce", "0x5"},
+               {"gas", "0x5208"},
+               {"value", "0xde0b6b3a7640000"},
+               {"input", hex(68, i)},
+               {"maxPriorityFeePerGas", "0x3b9aca00"},
+               {"maxFeePerGas", "0x4a817c800"},
+               {"gasPrice", "0x4a817c800"},
+               {"accessList",
+                {{{"address", hex(20, i + 2)},
+                  {"storageKeys", {hex(32, i), hex(32, i + 1)}}}}},
+               {"chainId", "0x1"},
+               {"yParity", "0x1"},
+               {"v", "0x1"},
+               {"r", hex(32, i + 5)},
+               {"s", hex(32, i + 6)}};
+    if (i % 7 == 0)
+        tx["blobVersionedHashes"] = {hex(32, i)};
+    return tx;
+}
+
+// The response text for a block of 300 transactions.
+std::string fixture()
+{
+    json block = {{"number", "0x12a05f2"},
+                  {"hash", hex(32, 9)},
+                  {"parentHash", hex(32, 8)},
+                  {"nonce", "0x0000000000000000"},
+                  {"sha3Uncles", hex(32, 3)},
+                  {"logsBloom", hex(256, 1)},
+                  {"transactionsRoot", hex(32, 4)},
+                  {"stateRoot", hex(32, 5)},
+                  {"receiptsRoot", hex(32, 6)},
+                  {"miner", hex(20, 7)},
+                  {"mixHash", hex(32, 2)},
+                  {"difficulty", "0x0"},
+                  {"extraData", "0x6265617665726275696c642e6f7267"},
+                  {"size", "0x2a1f3"},
+                  {"gasLimit", "0x1c9c380"},
+                  {"gasUsed", "0x1c8a4e1"},
+                  {"timestamp", "0x65f1a2b3"},
+                  {"uncles", json::array()},
+                  {"baseFeePerGas", "0x7"},
+                  {"withdrawalsRoot", hex(32, 11)},
+                  {"withdrawals",
+                   {{{"index", "0x1"},
+                     {"validatorIndex", "0x2"},
+                     {"address", hex(20, 3)},
+                     {"amount", "0x4"}}}},
+                  {"blobGasUsed", "0x0"},
+                  {"excessBlobGas", "0x0"},
+                  {"parentBeaconBlockRoot", hex(32, 12)},
+                  {"transactions", json::array()}};
+    for (int i = 0; i < 300; i++)
+        block["transactions"].push_back(transaction(i));
+    return json({{"jsonrpc", "2.0"}, {"id", 1}, {"result", block}}).dump();
+}
+
+Block viaDom(const std::string& text)
+{
+    json response = json::parse(text);
+    return response["result"].get<Block>();
+}
+
+Block viaReader(const std::string& text)
+{
+    Block block;
+    if (read(text, block) != web3::type::response::ReadStatus::Value)
+        std::abort();
+    return block;
+}
+
+template <typename Parse>
+double millisPerBlock(const std::string& text, int iterations, Parse parse)
+{
+    size_t transactions = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++)
+        transactions += parse(text).transactions.size();
+    double millis =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    if (transactions != 300u * iterations)
+        std::abort();
+    return millis / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    std::string text = fixture();
+
+    // Both paths must agree before their speed means anything.
+    Block dom = viaDom(text);
+    Block sax = viaReader(text);
+    if (dom.hash != sax.hash || dom.transactions.size() != 300 ||
+        sax.transactions.size() != 300 ||
+        dom.transactions[299].s != sax.transactions[299].s ||
+        dom.transactions[299].accessList[0].storageKeys !=
+            sax.transactions[299].accessList[0].storageKeys)
+    {
+        std::fprintf(stderr, "DOM and reader results differ\n");
+        return 1;
+    }
+
+    // Warm up the allocator.
+    millisPerBlock(text, 10, viaDom);
+    millisPerBlock(text, 10, viaReader);
+
+    double domMs = millisPerBlock(text, iterations, viaDom);
+    double readMs = millisPerBlock(text, iterations, viaReader);
+    double mb = text.size() / 1e6;
+    std::printf("300-transaction block, %.0f KiB, %d iterations\n",
+                text.size() / 1024.0, iterations);
+    std::printf("%-18s %10s %10s\n", "", "ms/block", "MB/s");
+    std::printf("%-18s %10.3f %10.1f\n", "DOM + from_json", domMs,
+                mb / domMs * 1e3);
+    std::printf("%-18s %10.3f %10.1f\n", "read()", readMs, mb / readMs * 1e3);
+    return 0;
+}
@@ -0,0 +1,360 @@
+// Round-trip cost of IPCClient against HTTPClient. One stub node answers
+// the same canned replies over a Unix socket and over HTTP on loopback, so
+// the difference is the transport: framing, connection setup and the
+// client's own overhead.
+//
+//   transport_bench [iterations] [threads]
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/connector.h"
+#include "core/ipc.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+// Request mix: small scalar replies, a contract call and a block header
+// with a few hundred transaction hashes.
+struct Call
+{
+    const char* method;
+    const char* params;
+    std::string result;
+};
+
+std::vector<Call> requestMix()
+{
+    std::string block =
+        R"({"number":"0x10d4f","hash":"0x)" + std::string(64, 'a') +
+        R"(","parentHash":"0x)" + std::string(64, 'b') +
+        R"(","gasUsed":"0x1c9c380","timestamp":"0x65f1a2b3","transactions":[)";
+    for (int i = 0; i < 200; i++)
+        block += (i ? ",\"0x" : "\"0x") + std::string(64, 'c') + "\"";
+    block += "]}";
+
+    return {
+        {"eth_blockNumber", "[]", "\"0x10d4f\""},
+        {"eth_getBalance",
+         R"(["0x00000000219ab540356cbb839cbe05303d7705fa","latest"])",
+         "\"0x1bc16d674ec80000\""},
+        {"eth_call",
+         R"([{"to":"0x00000000219ab540356cbb839cbe05303d7705fa",)"
+         R"("data":"0x70a08231"},"latest"])",
+         "\"0x" + std::string(192, '0') + "\""},
+        {"eth_getBlockByNumber", R"(["0x10d4f",false])", block},
+    };
+}
+
+std::string request(const Call& call, int id)
+{
+    return R"({"jsonrpc":"2.0","id":)" + std::to_string(id) +
+           R"(,"method":")" + call.method + R"(","params":)" + call.params +
+           "}";
+}
+
+/**
+ * @brief Loopback node answering the request mix over a Unix socket and
+ * over HTTP.
+ *
+ * Every connection gets its own thread. Replies are the canned result for
+ * the method with the request's id echoed back.
+ */
+class StubNode
+{
+   public:
+    explicit StubNode(const std::vector<Call>& calls)
+        : calls_{calls},
+          path_{"/tmp/web3-transport-bench-" + std::to_string(getpid()) +
+                ".ipc"}
+    {
+        unix_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un un{};
+        un.sun_family = AF_UNIX;
+        std::strncpy(un.sun_path, path_.c_str(), sizeof(un.sun_path) - 1);
+        unlink(path_.c_str());
+        if (unix_ < 0 ||
+            bind(unix_, reinterpret_cast<sockaddr*>(&un), sizeof(un)) != 0 ||
+            listen(unix_, 16) != 0)
+            throw std::runtime_error("StubNode: cannot listen on " + path_);
+
+        tcp_ = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(tcp_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in in{};
+        in.sin_family = AF_INET;
+        in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t size = sizeof(in);
+        if (tcp_ < 0 ||
+            bind(tcp_, reinterpret_cast<sockaddr*>(&in), size) != 0 ||
+            listen(tcp_, 128) != 0 ||
+            getsockname(tcp_, reinterpret_cast<sockaddr*>(&in), &size) != 0)
+            throw std::runtime_error("StubNode: cannot listen on loopback");
+        port_ = ntohs(in.sin_port);
+
+        acceptors_.emplace_back([this] { accept(unix_, false); });
+        acceptors_.emplace_back([this] { accept(tcp_, true); });
+    }
+
+    ~StubNode()
+    {
+        stopping_ = true;
+        shutdown(unix_, SHUT_RDWR);
+        shutdown(tcp_, SHUT_RDWR);
+        for (auto& t : acceptors_)
+            t.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int fd : connections_)
+                shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& t : workers_)
+            t.join();
+        for (int fd : connections_)
+            close(fd);
+        close(unix_);
+        close(tcp_);
+        unlink(path_.c_str());
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    int port() const
+    {
+        return port_;
+    }
+
+   private:
+    void accept(int listener, bool http)
+    {
+        while (!stopping_)
+        {
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            std::lock_guard<std::mutex> lock(mutex_);
+            connections_.push_back(fd);
+            workers_.emplace_back(
+                [this, fd, http] { http ? serveHttp(fd) : serveIpc(fd); });
+        }
+    }
+
+    // Newline separated requests, as IPCClient writes them.
+    void serveIpc(int fd)
+    {
+        std::string buffer;
+        while (read(fd, buffer))
+        {
+            size_t end;
+            while ((end = buffer.find('\n')) != std::string::npos)
+            {
+                std::string out = reply(buffer.substr(0, end)) + "\n";
+                buffer.erase(0, end + 1);
+                if (!write(fd, out))
+                    return;
+            }
+        }
+    }
+
+    void serveHttp(int fd)
+    {
+        std::string buffer;
+        while (true)
+        {
+            size_t head;
+            while ((head = buffer.find("\r\n\r\n")) == std::string::npos)
+                if (!read(fd, buffer))
+                    return;
+
+            size_t length = 0;
+            std::string headers = buffer.substr(0, head);
+            for (auto& c : headers)
+                c = std::tolower(static_cast<unsigned char>(c));
+            size_t field = headers.find("content-length:");
+            if (field != std::string::npos)
+                length = std::strtoul(headers.c_str() + field + 15, nullptr,
+                                      10);
+
+            size_t body = head + 4;
+            while (buffer.size() < body + length)
+                if (!read(fd, buffer))
+                    return;
+
+            std::string content = reply(buffer.substr(body, length));
+            buffer.erase(0, body + length);
+            if (!write(fd, "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: " +
+                               std::to_string(content.size()) + "\r\n\r\n" +
+                               content))
+                return;
+        }
+    }
+
+    std::string reply(const std::string& text)
+    {
+        auto request = nlohmann::json::parse(text);
+        std::string method = request["method"];
+        std::string id = request["id"].dump();
+        for (const auto& call : calls_)
+            if (method == call.method)
+                return R"({"jsonrpc":"2.0","id":)" + id +
+                       R"(,"result":)" + call.result + "}";
+        return R"({"jsonrpc":"2.0","id":)" + id +
+               R"(,"error":{"code":-32601,"message":"method not found"}})";
+    }
+
+    static bool read(int fd, std::string& buffer)
+    {
+        char chunk[65536];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return false;
+        buffer.append(chunk, n);
+        return true;
+    }
+
+    static bool write(int fd, const std::string& data)
+    {
+        for (size_t sent = 0; sent < data.size();)
+        {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent,
+                               MSG_NOSIGNAL);
+            if (n <= 0)
+                return false;
+            sent += n;
+        }
+        return true;
+    }
+
+    const std::vector<Call>& calls_;
+    std::string path_;
+    int unix_ = -1;
+    int tcp_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::mutex mutex_;
+    std::vector<int> connections_;
+    std::vector<std::thread> acceptors_;
+    std::vector<std::thread> workers_;
+};
+
+// Nanoseconds for one request, which must succeed.
+int64_t roundTrip(web3::rpc::IConnector& connector, const Call& call, int id)
+{
+    std::string message = request(call, id);
+    auto start = Clock::now();
+    std::string response = connector.send(message);
+    auto elapsed = Clock::now() - start;
+    if (response.find("\"result\"") == std::string::npos)
+        throw std::runtime_error("unexpected reply: " + response);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+        .count();
+}
+
+// Sends every request of the mix `iterations` times from each of `threads`
+// threads sharing one connector. Returns microseconds per request for each
+// method of the mix.
+std::vector<double> run(web3::rpc::IConnector& connector,
+                        const std::vector<Call>& calls, int iterations,
+                        int threads)
+{
+    std::vector<std::atomic<int64_t>> nanos(calls.size());
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back(
+            [&, t]
+            {
+                try
+                {
+                    for (int i = 0; i < iterations; i++)
+                        for (size_t c = 0; c < calls.size(); c++)
+                            nanos[c] += roundTrip(connector, calls[c], t);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                }
+            });
+    for (auto& w : workers)
+        w.join();
+    if (error)
+        std::rethrow_exception(error);
+
+    std::vector<double> micros;
+    for (auto& n : nanos)
+        micros.push_back(n / 1000.0 / iterations / threads);
+    return micros;
+}
+
+void report(const char* name, const std::vector<Call>& calls,
+            const std::vector<double>& micros, double seconds, int requests)
+{
+    std::printf("%-6s", name);
+    for (size_t c = 0; c < calls.size(); c++)
+        std::printf(" %22.1f", micros[c]);
+    std::printf(" %12.0f\n", requests / seconds);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+
+    std::vector<Call> calls = requestMix();
+    StubNode node(calls);
+    web3::rpc::IPCClient ipc(node.path());
+    web3::rpc::HTTPClient http("127.0.0.1", node.port());
+
+    // Warm up connections and caches on both sides.
+    run(ipc, calls, 50, 1);
+    run(http, calls, 50, 1);
+
+    std::printf("%d iterations, %d thread(s); microseconds per request\n",
+                iterations, threads);
+    std::printf("%-6s", "");
+    for (const auto& call : calls)
+        std::printf(" %22s", call.method);
+    std::printf(" %12s\n", "requests/s");
+
+    int requests = iterations * threads * static_cast<int>(calls.size());
+    for (auto* connector :
+         {static_cast<web3::rpc::IConnector*>(&ipc),
+          static_cast<web3::rpc::IConnector*>(&http)})
+    {
+        auto start = Clock::now();
+        auto micros = run(*connector, calls, iterations, threads);
+        double seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+        report(connector == &ipc ? "ipc" : "http", calls, micros, seconds,
+               requests);
+    }
+    return 0;
+}
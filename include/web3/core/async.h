@@ -0,0 +1,102 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/iconnector.h"
+
+namespace web3::rpc
+{
+
+struct AsyncOptions
+{
+    // Requests beyond this many in flight wait in a queue.
+    size_t maxInFlight = 256;
+    // Per-request timeout, 0 disables it.
+    std::chrono::milliseconds requestTimeout = std::chrono::milliseconds(0);
+};
+
+/**
+ * @brief HTTP connector driving all requests from one curl_multi event loop.
+ *
+ * The loop runs on a dedicated thread, so any number of callers can keep
+ * requests in flight without blocking on each other. Response handlers are
+ * invoked on the loop thread and must not block.
+ */
+class AsyncHTTPClient : public IConnector
+{
+   public:
+    AsyncHTTPClient(const std::string& host, int port,
+                    const AsyncOptions& options = {});
+
+    ~AsyncHTTPClient() override;
+
+    AsyncHTTPClient(const AsyncHTTPClient&) = delete;
+    AsyncHTTPClient& operator=(const AsyncHTTPClient&) = delete;
+
+    std::string send(const std::string& request) override;
+
+    using IConnector::sendAsync;
+    uint64_t sendAsync(const std::string& request,
+                       ResponseHandler handler) override;
+
+    bool cancel(uint64_t requestId) override;
+
+    size_t inFlight() const;
+    size_t queued() const;
+
+   private:
+    struct Transfer
+    {
+        uint64_t id;
+        CURL* curl = nullptr;
+        std::string request;
+        std::string response;
+        ResponseHandler handler;
+    };
+
+    void run();
+    // Adds transfer to the multi handle and takes it. Returns the error
+    // for its handler, leaving transfer with the caller, if it cannot.
+    std::exception_ptr start(std::unique_ptr<Transfer>& transfer);
+    std::exception_ptr finish(Transfer& transfer, CURLcode result);
+    // Returns nullptr if curl cannot create a handle.
+    CURL* acquireHandle();
+    void releaseHandle(CURL* curl);
+
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb,
+                                void* userp);
+
+    std::string url_;
+    curl_slist* headers_;
+    AsyncOptions options_;
+    CURLM* multi_;
+
+    mutable std::mutex mutex_;
+    std::deque<std::unique_ptr<Transfer>> queue_;
+    // Ids whose handler has not been claimed by completion or cancel().
+    std::unordered_set<uint64_t> pending_;
+    std::vector<uint64_t> cancelled_;
+    std::atomic<size_t> active_;
+
+    // Only touched from the loop thread.
+    std::unordered_map<uint64_t, std::unique_ptr<Transfer>> running_;
+    std::vector<CURL*> handles_;
+
+    std::atomic<uint64_t> nextId_;
+    std::atomic<bool> stop_;
+    std::thread loop_;
+};
+
+}  // namespace web3::rpc
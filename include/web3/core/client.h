@@ -1,29 +1,37 @@
 #pragma once
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
-#include <variant>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "core/error.h"
 #include "core/iconnector.h"
+#include "core/json_scan.h"
+#include "core/request_writer.h"
 
 #define VERSION 2
 
 namespace web3::rpc
 {
 
-typedef std::variant<int, std::string> idType;
-
 struct JsonRPCResponse
 {
     idType id;
     nlohmann::json result;
 
-    JsonRPCResponse(const idType& id, const nlohmann::json& result)
-        : id(id), result(result)
+    JsonRPCResponse(const idType& id, nlohmann::json result)
+        : id(id), result(std::move(result))
     {
     }
 };
 
+class JsonRPCBatch;
+
 class JsonRPCClient
 {
    public:
@@ -33,11 +41,88 @@ class JsonRPCClient
     }
     virtual ~JsonRPCClient() = default;
 
+    // Request and response go through this thread's buffers, and a result
+    // that is a plain JSON string is read without a DOM, so once the
+    // buffers have grown such a call only allocates its result. Pass
+    // rpc::params(...) to keep the params from building JSON as well.
     template <typename Result, typename Input>
     Result callMethod(const idType& id, const std::string& method,
                       const Input& params)
     {
-        return sendRequest(id, method, params).result.template get<Result>();
+        RequestBuffer request;
+        writeRequest(request.str(), id, method, params);
+        ResponseBuffer response;
+        connector_.sendInto(request.str(), response.str());
+        return readResult<Result>(response.str());
+    }
+
+    // The response is parsed on the thread that calls get() on the future,
+    // keeping the connector's event loop free.
+    template <typename Result, typename Input>
+    std::future<Result> callMethodAsync(const idType& id,
+                                        const std::string& method,
+                                        const Input& params)
+    {
+        RequestBuffer request;
+        writeRequest(request.str(), id, method, params);
+        auto response = connector_.sendAsync(request.str());
+        return std::async(
+            std::launch::deferred,
+            [response = std::move(response)]() mutable
+            { return readResult<Result>(response.get()); });
+    }
+
+    // The callback runs on the connector's thread and receives a
+    // value-initialised Result when error is set. Returns the connector
+    // request id, usable with IConnector::cancel().
+    template <typename Result, typename Input>
+    uint64_t callMethodAsync(
+        const idType& id, const std::string& method, const Input& params,
+        std::function<void(Result result, std::exception_ptr error)> callback)
+    {
+        RequestBuffer request;
+        writeRequest(request.str(), id, method, params);
+        return connector_.sendAsync(
+            request.str(),
+            [callback = std::move(callback)](std::string response,
+                                             std::exception_ptr error)
+            {
+                Result result{};
+                if (!error)
+                {
+                    try
+                    {
+                        result = readResult<Result>(response);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                callback(std::move(result), error);
+            });
+    }
+
+    JsonRPCBatch batch();
+
+    // Returns the response text unparsed, for callers that read it with a
+    // streaming parser of their own.
+    template <typename Input>
+    std::string callMethodRaw(const idType& id, const std::string& method,
+                              const Input& params)
+    {
+        RequestBuffer request;
+        writeRequest(request.str(), id, method, params);
+        return connector_.send(request.str());
+    }
+
+    // Throws the exception callMethod() would have thrown for a response
+    // text that such a parser could not read.
+    [[noreturn]] static void throwError(const std::string& raw)
+    {
+        parseResponse(parseJson(raw));
+        throw JsonRPCException(Error::INTERNAL,
+                               "Unexpected result in server response.");
     }
 
    protected:
@@ -46,50 +131,74 @@ class JsonRPCClient
    private:
     uint64_t version_;
 
-    nlohmann::json buildRequest(const idType& id, const std::string& method,
-                                const nlohmann::json& params)
+    template <typename Input>
+    void writeRequest(std::string& out, const idType& id,
+                      const std::string& method, const Input& params) const
     {
-        nlohmann::json j = {{"jsonrpc", version_}, {"method", method}};
-        if (std::get_if<int>(&id) != nullptr)
-            j["id"] = std::get<int>(id);
-        else
-            j["id"] = std::get<std::string>(id);
-        if (!params.is_null() && !params.empty())
-            j["params"] = params;
+        RequestWriter::write(out, id, method, params, version_);
+    }
 
-        return j;
+    template <typename Result>
+    static Result readResult(std::string_view raw)
+    {
+        if constexpr (std::is_same_v<Result, std::string>)
+        {
+            std::string_view text;
+            if (stringResult(raw, text))
+                return std::string(text);
+        }
+        return take<Result>(parseResponse(parseJson(raw)).result);
     }
 
-    JsonRPCResponse sendRequest(const idType& id, const std::string& method,
-                                const nlohmann::json& params)
+    // Finds the result of a well-formed success response when it is a
+    // string without escapes. Anything else, errors included, is left to
+    // the full parse.
+    static bool stringResult(std::string_view raw, std::string_view& text)
     {
-        nlohmann::json j = buildRequest(id, method, params);
+        bool hasId = false;
+        bool failed = false;
+        std::string_view result;
+        bool wellFormed = scan::forEachMember(
+            raw, 0,
+            [&](std::string_view key, size_t begin, size_t end)
+            {
+                if (key == "result")
+                    result = raw.substr(begin, end - begin);
+                else if (key == "id")
+                    hasId = true;
+                else if (key == "error")
+                    failed = true;
+                return true;
+            });
+        size_t end = scan::valueEnd(raw);
+        if (!wellFormed || end == scan::npos ||
+            scan::skipSpace(raw, end) != raw.size() || !hasId || failed ||
+            result.size() < 2 || result.front() != '"' ||
+            result.back() != '"')
+            return false;
+        text = scan::unquote(result);
+        return text.find('\\') == std::string_view::npos;
+    }
 
-        try
+    // Moves the result out where the types allow rather than copying it.
+    template <typename Result>
+    static Result take(nlohmann::json&& result)
+    {
+        if constexpr (std::is_same_v<Result, nlohmann::json>)
+            return std::move(result);
+        else if constexpr (std::is_same_v<Result, std::string>)
         {
-            nlohmann::json response =
-                nlohmann::json::parse(connector_.send(j.dump()));
-
-            if (hasTypedKey(response, "error", nlohmann::json::value_t::object))
-                throw JsonRPCException::from_json(response["error"]);
-            else if (hasTypedKey(response, "error",
-                                 nlohmann::json::value_t::string))
-                throw JsonRPCException(Error::UNKNOWN, response["error"]);
+            if (auto* text = result.get_ptr<std::string*>())
+                return std::move(*text);
+        }
+        return result.template get<Result>();
+    }
 
-            if (hasKey(response, "result") && hasKey(response, "id"))
-            {
-                if (response["id"].type() == nlohmann::json::value_t::string)
-                    return JsonRPCResponse(
-                        response["id"].get<std::string>(),
-                        response["result"].get<nlohmann::json>());
-                else
-                    return JsonRPCResponse(
-                        response["id"].get<int>(),
-                        response["result"].get<nlohmann::json>());
-            }
-            throw JsonRPCException(
-                Error::INTERNAL,
-                R"(Invalid server response: neither "result"  nor "error" fields found.)");
+    static nlohmann::json parseJson(std::string_view raw)
+    {
+        try
+        {
+            return nlohmann::json::parse(raw.begin(), raw.end());
         }
         catch (nlohmann::json::parse_error& e)
         {
@@ -98,6 +207,175 @@ class JsonRPCClient
                 std::string("Invalid JSON response from server: ") + e.what());
         }
     }
+
+    static JsonRPCResponse parseResponse(nlohmann::json response)
+    {
+        if (hasTypedKey(response, "error", nlohmann::json::value_t::object) ||
+            hasTypedKey(response, "error", nlohmann::json::value_t::string))
+            throw JsonRPCException::from_json(response["error"]);
+
+        if (hasKey(response, "result") && hasKey(response, "id"))
+        {
+            if (response["id"].type() == nlohmann::json::value_t::string)
+                return JsonRPCResponse(response["id"].get<std::string>(),
+                                       std::move(response["result"]));
+            else
+                return JsonRPCResponse(response["id"].get<int>(),
+                                       std::move(response["result"]));
+        }
+        throw JsonRPCException(
+            Error::INTERNAL,
+            R"(Invalid server response: neither "result"  nor "error" fields found.)");
+    }
+
+    friend class JsonRPCBatch;
+};
+
+struct BatchEntry
+{
+    bool done = false;
+    nlohmann::json result;
+    std::exception_ptr error;
 };
 
+template <typename Result>
+class BatchResult
+{
+   public:
+    // Throws the entry's JsonRPCException if the node rejected this call, or
+    // if the batch has not been sent yet.
+    Result get() const
+    {
+        if (!entry_->done)
+            throw JsonRPCException(Error::INTERNAL,
+                                   "Batch has not been sent yet.");
+        if (entry_->error)
+            std::rethrow_exception(entry_->error);
+        return entry_->result.template get<Result>();
+    }
+
+    bool ok() const
+    {
+        return entry_->done && !entry_->error;
+    }
+
+   private:
+    friend class JsonRPCBatch;
+
+    explicit BatchResult(std::shared_ptr<BatchEntry> entry)
+        : entry_(std::move(entry))
+    {
+    }
+
+    std::shared_ptr<BatchEntry> entry_;
+};
+
+/**
+ * @brief Collects calls and sends them to the node as one JSON-RPC batch.
+ *
+ * Ids are assigned by the batch itself, so responses can be matched back to
+ * their calls whatever order the node answers in. A failing entry only
+ * fails its own BatchResult; transport and parse errors are thrown from
+ * send().
+ */
+class JsonRPCBatch
+{
+   public:
+    explicit JsonRPCBatch(JsonRPCClient& client)
+        : client_(client), requests_("[")
+    {
+    }
+
+    template <typename Result, typename Input>
+    BatchResult<Result> callMethod(const std::string& method,
+                                   const Input& params)
+    {
+        int id = static_cast<int>(entries_.size());
+        if (!entries_.empty())
+            requests_ += ',';
+        client_.writeRequest(requests_, id, method, params);
+        entries_.push_back(std::make_shared<BatchEntry>());
+        return BatchResult<Result>(entries_.back());
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    void send()
+    {
+        if (entries_.empty())
+            return;
+
+        // The closing bracket is only there while sending, so a batch that
+        // failed to send can be sent again.
+        requests_ += ']';
+        std::string raw;
+        try
+        {
+            raw = client_.connector_.send(requests_);
+        }
+        catch (...)
+        {
+            requests_.pop_back();
+            throw;
+        }
+        requests_.pop_back();
+
+        nlohmann::json response = JsonRPCClient::parseJson(raw);
+
+        // A node that rejects the batch as a whole answers with one object.
+        if (!response.is_array())
+        {
+            JsonRPCClient::parseResponse(response);
+            response = nlohmann::json::array({std::move(response)});
+        }
+
+        for (auto& item : response)
+        {
+            if (!hasKey(item, "id") || !item["id"].is_number_integer())
+                continue;
+            auto id = item["id"].get<int64_t>();
+            if (id < 0 || id >= static_cast<int64_t>(entries_.size()))
+                continue;
+
+            auto& entry = *entries_[id];
+            try
+            {
+                entry.result = std::move(
+                    JsonRPCClient::parseResponse(std::move(item)).result);
+            }
+            catch (JsonRPCException&)
+            {
+                entry.error = std::current_exception();
+            }
+            entry.done = true;
+        }
+
+        for (auto& entry : entries_)
+        {
+            if (entry->done)
+                continue;
+            entry->error = std::make_exception_ptr(JsonRPCException(
+                Error::INTERNAL, "Missing response for batch entry."));
+            entry->done = true;
+        }
+
+        requests_.assign(1, '[');
+        entries_.clear();
+    }
+
+   private:
+    JsonRPCClient& client_;
+    // Requests written so far, without the closing bracket.
+    std::string requests_;
+    std::vector<std::shared_ptr<BatchEntry>> entries_;
+};
+
+inline JsonRPCBatch JsonRPCClient::batch()
+{
+    return JsonRPCBatch(*this);
+}
+
 }  // namespace web3::rpc
@@ -17,6 +17,7 @@ class HTTPClient : public IConnector
     ~HTTPClient() override;
 
     std::string send(const std::string& request) override;
+    void sendInto(const std::string& request, std::string& response) override;
 
    private:
     static size_t writeCallback(void* contents, size_t size, size_t nmemb,
@@ -24,6 +25,8 @@ class HTTPClient : public IConnector
 
     std::string host_;
     int port_;
+    std::string url_;
+    curl_slist* headers_;
 };
 
 }  // namespace web3::rpc
@@ -83,13 +83,33 @@ class JsonRPCException : public std::exception
         return data;
     }
 
+    // True when the server answered with this error, so the request is
+    // known to have arrived. Transport failures leave it unset: such a
+    // request may or may not have been processed.
+    bool FromServer() const
+    {
+        return fromServer;
+    }
+
     const char* what() const noexcept override
     {
         return err.c_str();
     }
 
+    // Builds the exception for the "error" member of a response, which is
+    // an error object or, from some servers, a bare message.
     static inline JsonRPCException from_json(const nlohmann::json& value)
     {
+        JsonRPCException e = fromErrorObject(value);
+        e.fromServer = true;
+        return e;
+    }
+
+   private:
+    static inline JsonRPCException fromErrorObject(const nlohmann::json& value)
+    {
+        if (value.is_string())
+            return JsonRPCException(Error::UNKNOWN, value.get<std::string>());
         bool has_code = hasTypedKey(value, "code",
                                     nlohmann::json::value_t::number_integer) ||
                         hasTypedKey(value, "code",
@@ -114,10 +134,10 @@ class JsonRPCException : public std::exception
             R"(Invalid Ethereum nlohmann::json-RPC error response)");
     }
 
-   private:
     int code;
     std::string message;
     nlohmann::json data;
     std::string err;
+    bool fromServer = false;
 };
 }  // namespace web3::rpc
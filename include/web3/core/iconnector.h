@@ -1,15 +1,70 @@
 #pragma once
-#include <string>
-
-#pragma once
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <string>
 
 namespace web3::rpc
 {
+
+// Receives either the raw response or the error that prevented it.
+using ResponseHandler =
+    std::function<void(std::string response, std::exception_ptr error)>;
+
 class IConnector
 {
    public:
     virtual ~IConnector() = default;
     virtual std::string send(const std::string& request) = 0;
+
+    // As send(), but replaces the contents of response, so a caller reusing
+    // one string does not allocate per response once it has grown to fit.
+    virtual void sendInto(const std::string& request, std::string& response)
+    {
+        response = send(request);
+    }
+
+    // Connectors without native async support complete the request on the
+    // calling thread before returning. Returns an id usable with cancel().
+    virtual uint64_t sendAsync(const std::string& request,
+                               ResponseHandler handler)
+    {
+        std::string response;
+        std::exception_ptr error;
+        try
+        {
+            response = send(request);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        handler(std::move(response), error);
+        return 0;
+    }
+
+    // Returns true if the request was still pending and has been dropped;
+    // its handler is then called with an error.
+    virtual bool cancel(uint64_t /*requestId*/)
+    {
+        return false;
+    }
+
+    std::future<std::string> sendAsync(const std::string& request)
+    {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto future = promise->get_future();
+        sendAsync(request,
+                  [promise](std::string response, std::exception_ptr error)
+                  {
+                      if (error)
+                          promise->set_exception(error);
+                      else
+                          promise->set_value(std::move(response));
+                  });
+        return future;
+    }
 };
 }  // namespace web3::rpc
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "core/stream.h"
+
+namespace web3::rpc
+{
+
+/**
+ * @brief JSON-RPC over a node's Unix domain socket (geth/anvil .ipc path).
+ *
+ * Messages are concatenated JSON values with no framing of their own, so the
+ * reader splits the byte stream at top-level value boundaries.
+ */
+class IPCClient : public StreamConnector
+{
+   public:
+    explicit IPCClient(const std::string& path);
+
+    ~IPCClient() override;
+
+    IPCClient(const IPCClient&) = delete;
+    IPCClient& operator=(const IPCClient&) = delete;
+
+   protected:
+    void write(const std::string& message) override;
+
+   private:
+    void run();
+
+    int fd_;
+    std::mutex writeMutex_;
+    std::atomic<bool> closing_;
+    std::thread reader_;
+};
+
+}  // namespace web3::rpc
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+
+namespace web3::rpc::scan
+{
+
+/**
+ * Structural JSON scanning without building a DOM.
+ *
+ * These helpers only track nesting and string boundaries. They locate values
+ * inside well-formed JSON text and report incomplete text, but they are not
+ * validators: malformed input yields unspecified spans, never a crash.
+ */
+
+constexpr size_t npos = std::string_view::npos;
+
+inline size_t skipSpace(std::string_view text, size_t pos)
+{
+    while (pos < text.size() &&
+           (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' ||
+            text[pos] == '\t'))
+        ++pos;
+    return pos;
+}
+
+// Given the offset of an opening quote, returns the offset just past the
+// closing quote, or npos if the string is not terminated.
+inline size_t stringEnd(std::string_view text, size_t pos)
+{
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* p = begin + pos + 1;
+    while (p < end)
+    {
+        auto* quote =
+            static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (!quote)
+            return npos;
+
+        // The quote is escaped if preceded by an odd number of backslashes.
+        size_t slashes = 0;
+        for (const char* q = quote - 1; q >= p && *q == '\\'; --q)
+            ++slashes;
+        if ((slashes & 1) == 0)
+            return quote - begin + 1;
+        p = quote + 1;
+    }
+    return npos;
+}
+
+// Returns the offset just past the value starting at or after pos, or npos
+// if the text ends before the value does.
+inline size_t valueEnd(std::string_view text, size_t pos = 0)
+{
+    pos = skipSpace(text, pos);
+    if (pos >= text.size())
+        return npos;
+
+    char c = text[pos];
+    if (c == '"')
+        return stringEnd(text, pos);
+
+    if (c != '{' && c != '[')
+    {
+        while (pos < text.size())
+        {
+            c = text[pos];
+            if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' ||
+                c == '\r' || c == '\t')
+                return pos;
+            ++pos;
+        }
+        return npos;
+    }
+
+    size_t depth = 0;
+    while (pos < text.size())
+    {
+        c = text[pos];
+        if (c == '"')
+        {
+            pos = stringEnd(text, pos);
+            if (pos == npos)
+                return npos;
+            continue;
+        }
+        if (c == '{' || c == '[')
+            ++depth;
+        else if ((c == '}' || c == ']') && --depth == 0)
+            return pos + 1;
+        ++pos;
+    }
+    return npos;
+}
+
+// Calls f(key, valueBegin, valueEnd) for each member of the object at or
+// after pos. The key is returned raw, without quotes or unescaping. Stops
+// early when f returns false. Returns false if the object is malformed.
+template <typename F>
+bool forEachMember(std::string_view text, size_t pos, F&& f)
+{
+    pos = skipSpace(text, pos);
+    if (pos >= text.size() || text[pos] != '{')
+        return false;
+    pos = skipSpace(text, pos + 1);
+    if (pos < text.size() && text[pos] == '}')
+        return true;
+
+    while (pos < text.size())
+    {
+        if (text[pos] != '"')
+            return false;
+        size_t keyEnd = stringEnd(text, pos);
+        if (keyEnd == npos)
+            return false;
+        std::string_view key = text.substr(pos + 1, keyEnd - pos - 2);
+
+        pos = skipSpace(text, keyEnd);
+        if (pos >= text.size() || text[pos] != ':')
+            return false;
+        size_t begin = skipSpace(text, pos + 1);
+        size_t end = valueEnd(text, begin);
+        if (end == npos)
+            return false;
+        if (!f(key, begin, end))
+            return true;
+
+        pos = skipSpace(text, end);
+        if (pos >= text.size())
+            return false;
+        if (text[pos] == '}')
+            return true;
+        if (text[pos] != ',')
+            return false;
+        pos = skipSpace(text, pos + 1);
+    }
+    return false;
+}
+
+// Calls f(valueBegin, valueEnd) for each element of the array at or after
+// pos. Stops early when f returns false. Returns false if malformed.
+template <typename F>
+bool forEachElement(std::string_view text, size_t pos, F&& f)
+{
+    pos = skipSpace(text, pos);
+    if (pos >= text.size() || text[pos] != '[')
+        return false;
+    pos = skipSpace(text, pos + 1);
+    if (pos < text.size() && text[pos] == ']')
+        return true;
+
+    while (pos < text.size())
+    {
+        size_t end = valueEnd(text, pos);
+        if (end == npos)
+            return false;
+        if (!f(pos, end))
+            return true;
+
+        pos = skipSpace(text, end);
+        if (pos >= text.size())
+            return false;
+        if (text[pos] == ']')
+            return true;
+        if (text[pos] != ',')
+            return false;
+        pos = skipSpace(text, pos + 1);
+    }
+    return false;
+}
+
+// Returns the raw text of a top-level member's value, or an empty view.
+inline std::string_view member(std::string_view object, std::string_view key)
+{
+    std::string_view found;
+    forEachMember(object, 0,
+                  [&](std::string_view k, size_t begin, size_t end)
+                  {
+                      if (k != key)
+                          return true;
+                      found = object.substr(begin, end - begin);
+                      return false;
+                  });
+    return found;
+}
+
+// Strips the quotes from a raw JSON string value without unescaping it.
+inline std::string_view unquote(std::string_view value)
+{
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+        return value.substr(1, value.size() - 2);
+    return value;
+}
+
+/**
+ * @brief Finds message boundaries in a stream of concatenated JSON values.
+ *
+ * State is kept between calls, so bytes are looked at once no matter how
+ * the stream is chunked. Only objects and arrays are recognised as messages;
+ * anything between them is skipped.
+ */
+class Splitter
+{
+   public:
+    // Returns the offset just past the next complete message in buffer, or
+    // npos once all of buffer has been scanned without completing one.
+    size_t next(std::string_view buffer)
+    {
+        for (; pos_ < buffer.size(); ++pos_)
+        {
+            char c = buffer[pos_];
+            if (depth_ == 0)
+            {
+                if (c == '{' || c == '[')
+                {
+                    begin_ = pos_;
+                    depth_ = 1;
+                }
+                continue;
+            }
+            if (inString_)
+            {
+                if (escaped_)
+                    escaped_ = false;
+                else if (c == '\\')
+                    escaped_ = true;
+                else if (c == '"')
+                    inString_ = false;
+                continue;
+            }
+            if (c == '"')
+                inString_ = true;
+            else if (c == '{' || c == '[')
+                ++depth_;
+            else if ((c == '}' || c == ']') && --depth_ == 0)
+                return ++pos_;
+        }
+        return npos;
+    }
+
+    // Offset where the message returned by the last next() call starts.
+    size_t begin() const
+    {
+        return begin_;
+    }
+
+    // Tells the splitter the first n bytes were dropped from the buffer.
+    void discard(size_t n)
+    {
+        pos_ -= n;
+        begin_ = begin_ >= n ? begin_ - n : 0;
+    }
+
+   private:
+    size_t pos_ = 0;
+    size_t begin_ = 0;
+    size_t depth_ = 0;
+    bool inString_ = false;
+    bool escaped_ = false;
+};
+
+}  // namespace web3::rpc::scan
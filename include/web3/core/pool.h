@@ -0,0 +1,82 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/iconnector.h"
+
+namespace web3::rpc
+{
+
+struct PoolOptions
+{
+    // Upper bound on simultaneously open handles (and so connections).
+    size_t maxHandles = 8;
+    // Handles left unused for longer than this are closed.
+    std::chrono::milliseconds idleTimeout = std::chrono::seconds(30);
+    // Per-request timeout, 0 disables it.
+    std::chrono::milliseconds requestTimeout = std::chrono::milliseconds(0);
+};
+
+/**
+ * @brief HTTP connector that keeps a pool of reusable CURL handles.
+ *
+ * Every handle owns a keep-alive connection to the node, so requests after
+ * the first one skip the TCP handshake. A calling thread checks a handle out
+ * for the duration of one request; when several handles are idle the one the
+ * same thread used last is preferred. When all handles are busy and the pool
+ * is full, callers block until one is returned.
+ */
+class PooledHTTPClient : public IConnector
+{
+   public:
+    PooledHTTPClient(const std::string& host, int port,
+                     const PoolOptions& options = {});
+
+    ~PooledHTTPClient() override;
+
+    PooledHTTPClient(const PooledHTTPClient&) = delete;
+    PooledHTTPClient& operator=(const PooledHTTPClient&) = delete;
+
+    std::string send(const std::string& request) override;
+    void sendInto(const std::string& request, std::string& response) override;
+
+    size_t openHandles() const;
+    size_t idleHandles() const;
+
+   private:
+    struct Handle
+    {
+        CURL* curl;
+        std::thread::id lastOwner;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    class Lease;
+
+    CURL* checkout();
+    void checkin(CURL* curl);
+    CURL* createHandle();
+    void evictExpired(std::vector<CURL*>& expired);
+
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb,
+                                void* userp);
+
+    std::string url_;
+    curl_slist* headers_;
+    PoolOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<Handle> idle_;
+    size_t open_;
+};
+
+}  // namespace web3::rpc
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+namespace web3::rpc
+{
+
+typedef std::variant<int, std::string> idType;
+
+/**
+ * @brief Positional params written straight into the request, without a
+ * JSON array built for them first. Made by rpc::params().
+ *
+ * Only references to the arguments are kept, so the object must not outlive
+ * the expression it is made in.
+ */
+template <typename... Args>
+struct Params
+{
+    std::tuple<const Args&...> args;
+};
+
+// Strings, booleans and integers are written as they are; anything else,
+// such as a request struct, goes through its to_json.
+template <typename... Args>
+Params<Args...> params(const Args&... args)
+{
+    return Params<Args...>{std::tie(args...)};
+}
+
+/**
+ * @brief Serializes JSON-RPC requests straight into a string.
+ *
+ * The output matches nlohmann::json::dump() of the equivalent request
+ * object, members in the same order, but nothing is built on the way: once
+ * the target string has grown to fit, writing a request does not allocate.
+ */
+class RequestWriter
+{
+   public:
+    // Appends the request object; params are left out when null or empty.
+    static void write(std::string& out, const idType& id,
+                      std::string_view method, const nlohmann::json& params,
+                      uint64_t version)
+    {
+        writeHead(out, id, method, version);
+        if (!params.is_null() && !params.empty())
+        {
+            out += ",\"params\":";
+            writeValue(out, params);
+        }
+        out += '}';
+    }
+
+    template <typename... Args>
+    static void write(std::string& out, const idType& id,
+                      std::string_view method, const Params<Args...>& params,
+                      uint64_t version)
+    {
+        writeHead(out, id, method, version);
+        if constexpr (sizeof...(Args) > 0)
+        {
+            out += ",\"params\":[";
+            std::apply(
+                [&](const auto&... args)
+                {
+                    size_t i = 0;
+                    ((out += i++ ? "," : "", writeParam(out, args)), ...);
+                },
+                params.args);
+            out += ']';
+        }
+        out += '}';
+    }
+
+    static void writeValue(std::string& out, const nlohmann::json& value)
+    {
+        using value_t = nlohmann::json::value_t;
+        switch (value.type())
+        {
+            case value_t::null:
+                out += "null";
+                break;
+            case value_t::boolean:
+                out += value.get<bool>() ? "true" : "false";
+                break;
+            case value_t::number_integer:
+                writeInteger(out, value.get<int64_t>());
+                break;
+            case value_t::number_unsigned:
+                writeInteger(out, value.get<uint64_t>());
+                break;
+            case value_t::string:
+                writeString(out, value.get_ref<const std::string&>());
+                break;
+            case value_t::array:
+            {
+                out += '[';
+                bool first = true;
+                for (const auto& element : value)
+                {
+                    if (!first)
+                        out += ',';
+                    first = false;
+                    writeValue(out, element);
+                }
+                out += ']';
+                break;
+            }
+            case value_t::object:
+            {
+                out += '{';
+                bool first = true;
+                for (const auto& member : value.items())
+                {
+                    if (!first)
+                        out += ',';
+                    first = false;
+                    writeString(out, member.key());
+                    out += ':';
+                    writeValue(out, member.value());
+                }
+                out += '}';
+                break;
+            }
+            case value_t::binary:
+                throw std::invalid_argument(
+                    "RequestWriter: binary values have no JSON text");
+            default:
+                // Floats are rare in requests; nlohmann's formatting keeps
+                // them round-trippable.
+                out += value.dump();
+                break;
+        }
+    }
+
+    // Escapes quotes, backslashes and control characters; UTF-8 is copied
+    // as is.
+    static void writeString(std::string& out, std::string_view text)
+    {
+        static const char digits[] = "0123456789abcdef";
+        out += '"';
+        size_t run = 0;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+
+            out.append(text.data() + run, i - run);
+            run = i + 1;
+            switch (c)
+            {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                case '\b':
+                    out += "\\b";
+                    break;
+                case '\f':
+                    out += "\\f";
+                    break;
+                default:
+                    out += "\\u00";
+                    out += digits[c >> 4];
+                    out += digits[c & 0xf];
+                    break;
+            }
+        }
+        out.append(text.data() + run, text.size() - run);
+        out += '"';
+    }
+
+   private:
+    static void writeHead(std::string& out, const idType& id,
+                          std::string_view method, uint64_t version)
+    {
+        out += "{\"id\":";
+        if (const int* number = std::get_if<int>(&id))
+            writeInteger(out, *number);
+        else
+            writeString(out, std::get<std::string>(id));
+        out += ",\"jsonrpc\":";
+        writeInteger(out, version);
+        out += ",\"method\":";
+        writeString(out, method);
+    }
+
+    template <typename T>
+    static void writeParam(std::string& out, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            out += value ? "true" : "false";
+        else if constexpr (std::is_integral_v<T>)
+            writeInteger(out, value);
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            writeString(out, value);
+        else if constexpr (std::is_same_v<T, nlohmann::json>)
+            writeValue(out, value);
+        else
+            writeValue(out, nlohmann::json(value));
+    }
+
+    template <typename T>
+    static void writeInteger(std::string& out, T value)
+    {
+        char buf[24];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, result.ptr);
+    }
+};
+
+/**
+ * @brief Leases one of this thread's buffers for the lifetime of the
+ * object; Tag tells the buffers apart.
+ *
+ * The buffer keeps its capacity between requests, so a thread sending
+ * requests of similar size stops allocating after the first. A lease taken
+ * while the buffer is already leased further up the stack, by a connector
+ * issuing a request of its own, gets a private string instead.
+ */
+template <typename Tag>
+class ThreadBuffer
+{
+   public:
+    ThreadBuffer() : nested_(leased())
+    {
+        leased() = true;
+        str().clear();
+    }
+
+    ~ThreadBuffer()
+    {
+        if (nested_)
+            return;
+        leased() = false;
+        // Don't hold on to the memory of an unusually large batch.
+        if (shared().capacity() > maxRetained)
+            std::string().swap(shared());
+    }
+
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+    std::string& str()
+    {
+        return nested_ ? own_ : shared();
+    }
+
+   private:
+    static constexpr size_t maxRetained = 1 << 20;
+
+    static std::string& shared()
+    {
+        thread_local std::string buffer;
+        return buffer;
+    }
+
+    static bool& leased()
+    {
+        thread_local bool leased = false;
+        return leased;
+    }
+
+    bool nested_;
+    std::string own_;
+};
+
+// The text of the request being written.
+using RequestBuffer = ThreadBuffer<struct RequestBufferTag>;
+// The text of the response being read.
+using ResponseBuffer = ThreadBuffer<struct ResponseBufferTag>;
+
+}  // namespace web3::rpc
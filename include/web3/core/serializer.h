@@ -7,7 +7,7 @@ namespace nlohmann
 {
 
 template <typename T>
-struct nlohmann::adl_serializer<std::optional<T>>
+struct adl_serializer<std::optional<T>>
 {
     static void to_json(nlohmann::json& j, const std::optional<T>& opt)
     {
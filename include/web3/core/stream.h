@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/iconnector.h"
+
+namespace web3::rpc
+{
+
+// Receives the raw JSON text of each eth_subscription notification result.
+using NotificationHandler = std::function<void(std::string_view result)>;
+
+/**
+ * @brief Base for connectors speaking JSON-RPC over one persistent stream.
+ *
+ * Many requests can be outstanding at once. Outgoing ids are rewritten to
+ * connection-unique ones and restored on the way back, so callers may reuse
+ * ids freely. Server pushed eth_subscription notifications are routed to the
+ * handler registered by subscribe(). Handlers run on the reader thread of the
+ * derived connector and must not block.
+ *
+ * An error reply the node could not tie to a request (id null) fails the
+ * request it must belong to when only one is outstanding.
+ */
+class StreamConnector : public IConnector
+{
+   public:
+    ~StreamConnector() override = default;
+
+    std::string send(const std::string& request) override;
+
+    using IConnector::sendAsync;
+    uint64_t sendAsync(const std::string& request,
+                       ResponseHandler handler) override;
+
+    bool cancel(uint64_t requestId) override;
+
+    // Sends eth_subscribe with the given params (a JSON array) and blocks
+    // until the node confirms. Returns the subscription id.
+    std::string subscribe(const std::string& params,
+                          NotificationHandler handler);
+    bool unsubscribe(const std::string& subscriptionId);
+
+    // How long send() and subscribe() wait for their reply before cancelling
+    // the request and throwing a connection error. Zero, the default, waits
+    // for as long as the connection stays up.
+    void setTimeout(std::chrono::milliseconds timeout);
+
+   protected:
+    // Writes one complete message. Called concurrently, so implementations
+    // must serialise writes themselves.
+    virtual void write(const std::string& message) = 0;
+
+    // Derived connectors feed every complete incoming message here.
+    void onMessage(std::string_view message);
+    // Fails every outstanding request and drops all subscriptions.
+    void onClose(std::exception_ptr error);
+
+    // Writes all of data to a socket, throwing a connection error on failure.
+    static void sendAll(int fd, const char* data, size_t size);
+
+   private:
+    struct Pending
+    {
+        ResponseHandler handler;
+        // Wire id and original id text of every request in the message.
+        std::vector<std::pair<uint64_t, std::string>> ids;
+    };
+
+    std::string rewriteIds(const std::string& request, Pending& pending);
+    void onResponse(std::string_view message, std::string_view error);
+    void onNotification(std::string_view params);
+
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, uint64_t> wire_;
+    std::unordered_map<uint64_t, Pending> pending_;
+    std::unordered_map<std::string, std::shared_ptr<NotificationHandler>>
+        subscriptions_;
+    std::atomic<uint64_t> nextId_{1};
+    std::atomic<std::chrono::milliseconds> timeout_{
+        std::chrono::milliseconds::zero()};
+    bool closed_ = false;
+    std::exception_ptr closeError_;
+};
+
+}  // namespace web3::rpc
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "core/stream.h"
+
+namespace web3::rpc
+{
+
+/**
+ * @brief JSON-RPC over a persistent WebSocket (RFC 6455) connection.
+ *
+ * Plain ws:// only; the connection is opened by the constructor and a reader
+ * thread dispatches responses and subscription notifications. A message
+ * longer than the size limit closes the connection with status 1009.
+ */
+class WebSocketClient : public StreamConnector
+{
+   public:
+    WebSocketClient(const std::string& host, int port,
+                    const std::string& path = "/");
+
+    ~WebSocketClient() override;
+
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    // Largest message accepted from the node, fragments included; 32 MiB by
+    // default.
+    void setMaxMessageSize(size_t bytes);
+
+   protected:
+    void write(const std::string& message) override;
+
+   private:
+    void handshake(const std::string& host, int port, const std::string& path);
+    void run();
+    void sendFrame(uint8_t opcode, const char* payload, size_t size);
+    void readExact(char* out, size_t size);
+
+    int fd_;
+    std::mutex writeMutex_;
+    std::mt19937 maskRng_;
+    std::string buffer_;
+    size_t offset_;
+    std::atomic<bool> closing_;
+    std::atomic<size_t> maxMessageSize_;
+    std::thread reader_;
+};
+
+}  // namespace web3::rpc
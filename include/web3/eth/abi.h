@@ -0,0 +1,419 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "types/native.h"
+#include "types/response.h"
+#include "utils/keccak.h"
+
+namespace web3::eth::abi
+{
+
+enum class Kind : uint8_t
+{
+    Uint,
+    Int,
+    Address,
+    Bool,
+    FixedBytes,
+    Bytes,
+    String,
+    Array,
+    FixedArray,
+    Tuple
+};
+
+/**
+ * @brief A parsed Solidity ABI type.
+ *
+ * Whether the type is dynamic and how many bytes it takes in its parent's
+ * head are worked out once when it is built, not on every encode.
+ */
+struct Type
+{
+    Kind kind = Kind::Tuple;
+    // Bit width of Uint and Int, byte count of FixedBytes, element count of
+    // FixedArray.
+    size_t size = 0;
+    // Element type of arrays; members of tuples.
+    std::vector<Type> components;
+    // Member names of tuples, empty where the ABI gave none.
+    std::vector<std::string> names;
+    // Set on the FixedBytes of size 24 standing for a Solidity function
+    // type (an address followed by a selector), so its signature still
+    // names it function.
+    bool function = false;
+    bool dynamic = false;
+    size_t headSize = 0;
+
+    static Type elementary(Kind kind, size_t size = 0);
+    static Type array(Type element);
+    static Type fixedArray(Type element, size_t length);
+    static Type tuple(std::vector<Type> members,
+                      std::vector<std::string> names = {});
+
+    // Parses a canonical type such as "uint256", "bytes32[]" or
+    // "(address,uint256)[2]".
+    static Type parse(std::string_view text);
+
+    // Builds the type of an ABI JSON parameter, expanding "tuple" from its
+    // components.
+    static Type fromJson(const nlohmann::json& param);
+
+    // Canonical form, as used in signatures.
+    std::string canonical() const;
+
+   private:
+    void layout();
+};
+
+/**
+ * @brief A value to encode, or one that was decoded.
+ *
+ * Integers are held as uint256, signed ones in two's complement. Arrays and
+ * tuples are both a Value::Array. A std::string is taken as the text form of
+ * whatever type it is encoded as: a number, an address, 0x bytes or a
+ * Solidity string.
+ */
+class Value
+{
+   public:
+    using Array = std::vector<Value>;
+
+    Value() : data_(type::uint256())
+    {
+    }
+
+    Value(const type::uint256& value) : data_(value)
+    {
+    }
+
+    template <typename T,
+              std::enable_if_t<std::is_integral_v<T> &&
+                                   !std::is_same_v<T, bool>,
+                               int> = 0>
+    Value(T value)
+        : data_(value < 0 ? ~type::uint256(static_cast<uint64_t>(~value))
+                          : type::uint256(static_cast<uint64_t>(value)))
+    {
+    }
+
+    Value(bool value) : data_(value)
+    {
+    }
+
+    Value(const type::address& value) : data_(value)
+    {
+    }
+
+    Value(type::bytes value) : data_(std::move(value))
+    {
+    }
+
+    Value(std::string value) : data_(std::move(value))
+    {
+    }
+
+    Value(const char* value) : data_(std::string(value))
+    {
+    }
+
+    Value(Array value) : data_(std::move(value))
+    {
+    }
+
+    template <typename T>
+    bool is() const
+    {
+        return std::holds_alternative<T>(data_);
+    }
+
+    // Throws std::bad_variant_access if the value holds another type.
+    template <typename T>
+    const T& get() const
+    {
+        return std::get<T>(data_);
+    }
+
+    const type::uint256& toUint256() const
+    {
+        return get<type::uint256>();
+    }
+
+    bool toBool() const
+    {
+        return get<bool>();
+    }
+
+    const type::address& toAddress() const
+    {
+        return get<type::address>();
+    }
+
+    const type::bytes& toBytes() const
+    {
+        return get<type::bytes>();
+    }
+
+    const std::string& toString() const
+    {
+        return get<std::string>();
+    }
+
+    const Array& toArray() const
+    {
+        return get<Array>();
+    }
+
+    const Value& operator[](size_t index) const
+    {
+        return toArray().at(index);
+    }
+
+   private:
+    std::variant<type::uint256, bool, type::address, type::bytes, std::string,
+                 Array>
+        data_;
+};
+
+// Encoded size of value as type.
+size_t encodedSize(const Type& type, const Value& value);
+
+// Writes value as type to out, which must hold encodedSize() bytes.
+void encode(const Type& type, const Value& value, uint8_t* out);
+
+type::bytes encode(const Type& type, const Value& value);
+
+/**
+ * @brief Read-only view of one encoded value, pointing into the buffer it
+ * was decoded from.
+ *
+ * Nothing is copied or decoded up front: element and member access follow
+ * the head offsets on demand and accessors read the words in place. Every
+ * access is bounds checked and malformed data throws std::runtime_error.
+ * The buffer and the Type must outlive the view.
+ */
+class View
+{
+   public:
+    View(const Type& type, const uint8_t* data, size_t size)
+        : type_(&type), at_(data), end_(data + size)
+    {
+    }
+
+    const Type& type() const
+    {
+        return *type_;
+    }
+
+    // Integers; signed ones in two's complement.
+    type::uint256 toUint256() const;
+    // Throws if the integer does not fit.
+    uint64_t toU64() const;
+    type::address toAddress() const;
+    bool toBool() const;
+
+    // Payload of bytes, bytesN and string, in place.
+    std::string_view bytes() const;
+    std::string_view toString() const
+    {
+        return bytes();
+    }
+
+    // Element count of arrays, member count of tuples.
+    size_t length() const;
+    View operator[](size_t index) const;
+    // Tuple member by name.
+    View operator[](std::string_view name) const;
+
+    // Copies the value out.
+    Value toValue() const;
+
+   private:
+    View(const Type& type, const uint8_t* at, const uint8_t* end)
+        : type_(&type), at_(at), end_(end)
+    {
+    }
+
+    const uint8_t* word() const;
+
+    const Type* type_;
+    const uint8_t* at_;
+    const uint8_t* end_;
+};
+
+Value decode(const Type& type, const uint8_t* data, size_t size);
+
+struct Function
+{
+    std::string name;
+    // Canonical signature, e.g. "transfer(address,uint256)".
+    std::string signature;
+    std::array<uint8_t, 4> selector{};
+    Type inputs;
+    Type outputs;
+    std::string stateMutability;
+
+    static Function fromJson(const nlohmann::json& item);
+
+    // Selector followed by the encoded arguments, in one allocation.
+    type::bytes encodeCall(const Value::Array& args) const;
+
+    // Views the return data of a call as the outputs tuple.
+    View decodeOutput(const uint8_t* data, size_t size) const
+    {
+        return View(outputs, data, size);
+    }
+
+    View decodeOutput(const type::bytes& data) const
+    {
+        return decodeOutput(data.data(), data.size());
+    }
+};
+
+struct Event
+{
+    std::string name;
+    std::string signature;
+    // keccak256 of the signature; the first topic unless anonymous.
+    utils::Hash256 topic0{};
+    Type inputs;
+    std::vector<bool> indexed;
+    bool anonymous = false;
+    // The non-indexed inputs, as encoded in the log data.
+    Type data;
+    // Where each input is found: its topic for indexed inputs, its member
+    // of data otherwise.
+    std::vector<size_t> positions;
+
+    // Topics a log of this event carries: one per indexed input, after
+    // topic0 unless the event is anonymous.
+    size_t topicCount() const;
+
+    static Event fromJson(const nlohmann::json& item);
+};
+
+/**
+ * @brief A log viewed as the event it was emitted as.
+ *
+ * Indexed inputs are read from their topic. Indexed strings, bytes, arrays
+ * and tuples are only stored as their keccak256, so they read as bytes32.
+ */
+class LogView
+{
+   public:
+    // Throws if the topics do not match the event.
+    LogView(const Event& event, const utils::Hash256* topics,
+            size_t topicCount, const uint8_t* data, size_t size);
+
+    const Event& event() const
+    {
+        return *event_;
+    }
+
+    size_t length() const
+    {
+        return event_->inputs.components.size();
+    }
+
+    View operator[](size_t index) const;
+    View operator[](std::string_view name) const;
+
+    Value::Array toValues() const;
+
+   private:
+    const Event* event_;
+    const utils::Hash256* topics_;
+    View data_;
+};
+
+/**
+ * @brief Binary form of a response::Log, reusable across logs so decoding
+ * a stream of them does not allocate once the buffers have grown.
+ */
+struct RawLog
+{
+    type::address address;
+    std::vector<utils::Hash256> topics;
+    type::bytes data;
+
+    void assign(const type::response::Log& log);
+};
+
+/**
+ * @brief A contract ABI compiled into function and event descriptors.
+ *
+ * Built once from the JSON ABI; afterwards lookups are hash table probes and
+ * encoding never touches the JSON again.
+ */
+class Interface
+{
+   public:
+    Interface() = default;
+    explicit Interface(const nlohmann::json& abi);
+
+    // The lookup tables point into the descriptor vectors.
+    Interface(const Interface&) = delete;
+    Interface& operator=(const Interface&) = delete;
+
+    const std::vector<Function>& functions() const
+    {
+        return functions_;
+    }
+
+    const std::vector<Event>& events() const
+    {
+        return events_;
+    }
+
+    // Constructor arguments; an empty tuple if the ABI declares none.
+    const Type& constructor() const
+    {
+        return constructor_;
+    }
+
+    // All overloads of name, empty if there are none.
+    const std::vector<const Function*>& overloads(
+        const std::string& name) const;
+
+    // Looks up by name, or by full signature if name contains '('. Throws
+    // std::out_of_range if there is no match, std::runtime_error if a bare
+    // name is overloaded.
+    const Function& function(const std::string& name) const;
+
+    // The overload of name taking argCount arguments.
+    const Function& function(const std::string& name, size_t argCount) const;
+
+    const Function* findSelector(const uint8_t* selector) const;
+
+    const Event& event(const std::string& name) const;
+    const Event* findTopic(const utils::Hash256& topic0) const;
+
+    // Views the log as the event its first topic names, or returns
+    // std::nullopt for logs from events this ABI does not declare, including
+    // ones whose topic count does not match the declaration.
+    std::optional<LogView> decodeLog(const RawLog& log) const;
+
+   private:
+    std::vector<Function> functions_;
+    std::vector<Event> events_;
+    Type constructor_;
+    std::unordered_map<std::string, std::vector<const Function*>> byName_;
+    std::unordered_map<std::string, const Function*> bySignature_;
+    std::unordered_map<uint32_t, const Function*> bySelector_;
+    std::unordered_map<std::string, const Event*> eventsByName_;
+    // Keyed by the first 8 bytes of topic0.
+    std::unordered_map<uint64_t, const Event*> byTopic_;
+};
+
+}  // namespace web3::eth::abi
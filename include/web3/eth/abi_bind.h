@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "eth/abi.h"
+
+// Support for the typed bindings web3-abigen generates: conversions between
+// plain C++ types and abi::Value / abi::View, and word writers for calls
+// whose layout is fixed.
+namespace web3::eth::abi::bind
+{
+
+inline Value toValue(uint64_t v)
+{
+    return Value(v);
+}
+inline Value toValue(int64_t v)
+{
+    return Value(v);
+}
+inline Value toValue(const type::uint256& v)
+{
+    return Value(v);
+}
+inline Value toValue(const type::address& v)
+{
+    return Value(v);
+}
+inline Value toValue(bool v)
+{
+    return Value(v);
+}
+inline Value toValue(const type::bytes& v)
+{
+    return Value(v);
+}
+inline Value toValue(const std::string& v)
+{
+    return Value(v);
+}
+
+template <size_t N>
+Value toValue(const std::array<uint8_t, N>& v)
+{
+    return Value(type::bytes(v.begin(), v.end()));
+}
+
+// Generated tuple structs convert themselves.
+template <typename T>
+auto toValue(const T& v) -> decltype(v.toValue())
+{
+    return v.toValue();
+}
+
+template <typename T>
+Value toValue(const std::vector<T>& v)
+{
+    Value::Array items;
+    items.reserve(v.size());
+    for (const auto& item : v)
+        items.push_back(toValue(item));
+    return Value(std::move(items));
+}
+
+template <typename T, size_t N>
+Value toValue(const std::array<T, N>& v)
+{
+    Value::Array items;
+    items.reserve(N);
+    for (const auto& item : v)
+        items.push_back(toValue(item));
+    return Value(std::move(items));
+}
+
+inline void fromView(const View& v, uint64_t& out)
+{
+    out = v.toU64();
+}
+inline void fromView(const View& v, int64_t& out)
+{
+    // The type is at most int64, so the low limb holds the whole value.
+    out = static_cast<int64_t>(v.toUint256().toU64());
+}
+inline void fromView(const View& v, type::uint256& out)
+{
+    out = v.toUint256();
+}
+inline void fromView(const View& v, type::address& out)
+{
+    out = v.toAddress();
+}
+inline void fromView(const View& v, bool& out)
+{
+    out = v.toBool();
+}
+inline void fromView(const View& v, type::bytes& out)
+{
+    auto data = v.bytes();
+    out.assign(data.begin(), data.end());
+}
+inline void fromView(const View& v, std::string& out)
+{
+    out = v.toString();
+}
+
+template <size_t N>
+void fromView(const View& v, std::array<uint8_t, N>& out)
+{
+    auto data = v.bytes();
+    if (data.size() != N)
+        throw std::runtime_error("ABI: expected bytes" + std::to_string(N));
+    std::memcpy(out.data(), data.data(), N);
+}
+
+template <typename T>
+auto fromView(const View& v, T& out) -> decltype(T::fromView(v), void())
+{
+    out = T::fromView(v);
+}
+
+template <typename T>
+void fromView(const View& v, std::vector<T>& out)
+{
+    out.resize(v.length());
+    for (size_t i = 0; i < out.size(); i++)
+        fromView(v[i], out[i]);
+}
+
+template <typename T, size_t N>
+void fromView(const View& v, std::array<T, N>& out)
+{
+    for (size_t i = 0; i < N; i++)
+        fromView(v[i], out[i]);
+}
+
+// One head word each; bits is the declared width of integer types.
+inline void put(uint8_t* out, const type::uint256& v, size_t bits)
+{
+    if (bits < 256 && !(v >> bits).isZero())
+        throw std::runtime_error("ABI: value out of range for uint" +
+                                 std::to_string(bits));
+    auto be = v.toBytes();
+    std::memcpy(out, be.data(), 32);
+}
+
+inline void put(uint8_t* out, uint64_t v, size_t bits)
+{
+    put(out, type::uint256(v), bits);
+}
+
+inline void put(uint8_t* out, int64_t v, size_t bits)
+{
+    int64_t bound = bits < 64 ? int64_t(1) << (bits - 1) : 0;
+    if (bits < 64 && (v < -bound || v >= bound))
+        throw std::runtime_error("ABI: value out of range for int" +
+                                 std::to_string(bits));
+    std::memset(out, v < 0 ? 0xff : 0, 24);
+    uint64_t bits64 = static_cast<uint64_t>(v);
+    for (size_t i = 0; i < 8; i++)
+        out[31 - i] = static_cast<uint8_t>(bits64 >> (8 * i));
+}
+
+inline void put(uint8_t* out, const type::address& v, size_t)
+{
+    std::memset(out, 0, 12);
+    std::memcpy(out + 12, v.bytes.data(), 20);
+}
+
+inline void put(uint8_t* out, bool v, size_t)
+{
+    std::memset(out, 0, 32);
+    out[31] = v;
+}
+
+template <size_t N>
+void put(uint8_t* out, const std::array<uint8_t, N>& v, size_t)
+{
+    std::memset(out, 0, 32);
+    std::memcpy(out, v.data(), N);
+}
+
+// Selector followed by args encoded as the tuple inputs.
+inline type::bytes encodeCall(const std::array<uint8_t, 4>& selector,
+                              const Type& inputs, Value::Array args)
+{
+    Value value(std::move(args));
+    type::bytes out(4 + encodedSize(inputs, value));
+    std::memcpy(out.data(), selector.data(), 4);
+    encode(inputs, value, out.data() + 4);
+    return out;
+}
+
+}  // namespace web3::eth::abi::bind
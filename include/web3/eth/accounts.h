@@ -1,10 +1,16 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <vector>
 
+#include "eth/nonce.h"
+#include "eth/rpc.h"
 #include "types/native.h"
 #include "types/request.h"
+#include "utils.h"
 
 namespace web3::eth
 {
@@ -13,12 +19,16 @@ struct Account
 {
     type::address address;
     std::string privateKey;
-    uint64_t nonce = 0;
+    // privateKey parsed once, so signing never goes back to the hex.
+    utils::sign::SecretKey secretKey{};
+    // Shared by copies of the account, so they never hand out the same nonce.
+    std::shared_ptr<Nonce> nonce = std::make_shared<Nonce>();
 
     Account() = default;
-    Account(const type::address& addr, const std::string& privKey,
-            uint64_t nonce = 0)
-        : address(addr), privateKey(privKey), nonce(nonce)
+    Account(const type::address& addr, const std::string& privKey)
+        : address(addr),
+          privateKey(privKey),
+          secretKey(utils::sign::parseSecretKey(privKey))
     {
     }
 
@@ -28,36 +38,90 @@ struct Account
     }
 };
 
+/**
+ * @brief Accounts indexed by their raw address.
+ *
+ * Accounts live in an open-addressing table with linear probing, so a lookup
+ * hashes the 20 address bytes and touches a few adjacent slots. Any number of
+ * threads may look up concurrently; add, remove and clear take the lock
+ * exclusively. find() and get() share ownership of the stored account, so it
+ * stays alive for the caller even if another thread removes or replaces it.
+ */
 class Wallet
 {
    public:
+    // Adds the account, replacing any with the same address.
     void add(const Account& account);
-    void remove(const std::string& address);
+    bool remove(const type::address& address);
+    bool remove(const std::string& address)
+    {
+        return remove(type::address(address));
+    }
     void clear();
 
-    Account get(const std::string& address);
-    const std::map<std::string, Account> getAll() const;
+    size_t size() const;
+
+    // Returns nullptr if there is no such account.
+    std::shared_ptr<const Account> find(const type::address& address) const;
+
+    // Throws std::out_of_range if there is no such account.
+    std::shared_ptr<const Account> get(const type::address& address) const;
+    std::shared_ptr<const Account> get(const std::string& address) const
+    {
+        return get(type::address(address));
+    }
+
+    // Calls f(const Account&) for every account, holding the shared lock.
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& slot : slots_)
+            if (slot)
+                f(*slot);
+    }
 
    private:
-    std::map<std::string, Account> accounts_;
+    static uint64_t hash(const type::address& address);
+    // Slot holding address, or the empty slot where it would go.
+    size_t probe(const type::address& address) const;
+    void grow();
+
+    mutable std::shared_mutex mutex_;
+    // Shared with the callers of find() and get(); size is a power of two.
+    std::vector<std::shared_ptr<const Account>> slots_;
+    size_t count_ = 0;
 };
 
 class Accounts
 {
    public:
+    explicit Accounts(RPC& rpc) : nonces_{rpc}
+    {
+    }
+
     Account create();
     Account privateKeyToAccount(const std::string& privateKey);
 
+    // Hex network encoding of tx signed with the given key.
     std::string signTransaction(const type::request::Transaction& tx,
                                 const std::string& privateKey);
+    std::string signTransaction(const type::request::Transaction& tx,
+                                const Account& account);
 
     Wallet& wallet()
     {
         return wallet_;
     };
 
+    NonceManager& nonces()
+    {
+        return nonces_;
+    }
+
    private:
     Wallet wallet_;
+    NonceManager nonces_;
 };
 
 }  // namespace web3::eth
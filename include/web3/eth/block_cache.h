@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "eth/rpc.h"
+#include "types/response.h"
+
+namespace web3::eth
+{
+
+struct BlockCacheStats
+{
+    // Requests answered from the cache.
+    uint64_t hits = 0;
+    // Requests that went to the node.
+    uint64_t misses = 0;
+    // Requests that waited for a fetch of the same block already in flight.
+    uint64_t merged = 0;
+    // Times a number was found to belong to a different chain than the one
+    // cached for it.
+    uint64_t reorgs = 0;
+    size_t entries = 0;
+    // Estimated memory held by the cached blocks.
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Bounded cache of blocks in front of RPC, shared between threads.
+ *
+ * Blocks are kept by hash and evicted least recently used first once their
+ * estimated size exceeds the budget. A block fetched by number also records
+ * the hash that number resolved to and its parentHash. When a new block's
+ * parentHash does not match the cached block below it, or its hash does not
+ * match the parentHash of the cached block above it, the chain was
+ * reorganised and the stale numbers are forgotten. Blocks stay valid by
+ * hash, so only lookups by number are affected. Concurrent requests for
+ * the same block share one request to the node.
+ */
+class BlockCache
+{
+   public:
+    using BlockPtr = std::shared_ptr<const type::response::Block>;
+
+    explicit BlockCache(RPC& rpc, size_t maxBytes = 64 << 20)
+        : rpc_{rpc}, maxBytes_{maxBytes}
+    {
+    }
+
+    // As RPC::getBlockByNumber/getBlockByHash, with a null pointer for a
+    // block the node does not know. Missing blocks are not cached.
+    BlockPtr getBlockByNumber(uint64_t number, bool full = false);
+    BlockPtr getBlockByHash(const std::string& hash, bool full = false);
+
+    // Forgets which blocks numbers from `number` upwards resolve to, e.g.
+    // when a reorg is learnt of elsewhere.
+    void invalidateFrom(uint64_t number);
+    void clear();
+
+    BlockCacheStats stats() const;
+
+   private:
+    struct Entry
+    {
+        BlockPtr block;
+        bool full;
+        size_t bytes;
+        std::list<std::string>::iterator lru;
+    };
+
+    // Hash and parent of the block a number resolved to.
+    struct Link
+    {
+        std::string hash;
+        std::string parentHash;
+    };
+
+    // Runs get() unless the same request is already in flight, in which
+    // case its result is awaited instead. lock is held on entry.
+    BlockPtr fetch(const std::string& request, bool full, bool byNumber,
+                   std::unique_lock<std::mutex>& lock,
+                   const std::function<BlockPtr()>& get);
+    BlockPtr lookup(const std::string& key);
+    void insert(BlockPtr block, bool full);
+    void link(const type::response::Block& block);
+    void evict();
+
+    RPC& rpc_;
+    size_t maxBytes_;
+
+    mutable std::mutex mutex_;
+    // Keyed by lowercase hash plus whether transactions are full.
+    std::unordered_map<std::string, Entry> entries_;
+    // Most recently used first.
+    std::list<std::string> lru_;
+    std::map<uint64_t, Link> chain_;
+    std::unordered_map<std::string, std::shared_future<BlockPtr>> inFlight_;
+    // Bumped by invalidation, so fetches that started before it do not
+    // resolve numbers afterwards.
+    uint64_t generation_ = 0;
+    BlockCacheStats stats_;
+};
+
+}  // namespace web3::eth
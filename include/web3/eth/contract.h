@@ -1,58 +1,83 @@
 #pragma once
 
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
 
+#include "eth/abi.h"
 #include "eth/rpc.h"
 
 namespace web3::eth
 {
 
+/**
+ * @brief One call to a contract function, built up parameter by parameter.
+ *
+ * Parameters are kept as abi::Values and only encoded, in one pass, when the
+ * call is made. If the name is overloaded the overload is picked by the
+ * number of parameters given; a full signature such as
+ * "transfer(address,uint256)" selects one directly.
+ */
 class ContractMethod
 {
    public:
-    ContractMethod(const std::string& name, const nlohmann::json& abiMethod,
-                   web3::eth::RPC& rpc);
+    ContractMethod(std::shared_ptr<const abi::Interface> abi,
+                   const std::string& name, web3::eth::RPC& rpc);
 
     ContractMethod& param(const std::string& value);
     ContractMethod& param(uint64_t value);
     ContractMethod& param(bool value);
+    ContractMethod& param(abi::Value value);
+
+    // The function the parameters given so far resolve to.
+    const abi::Function& function() const;
+
+    // Selector followed by the encoded parameters.
+    type::bytes encodeData() const;
 
     std::string call(const std::string& to, const std::string& from = "");
+    // call(), with the return data decoded as the function's outputs.
+    abi::Value::Array query(const std::string& to,
+                            const std::string& from = "");
     std::string send(const std::string& from, const std::string& to,
                      const std::string& value = "0",
                      const std::string& gas = "");
 
    private:
     void reset();
-    std::string encodeData();
 
+    std::shared_ptr<const abi::Interface> abi_;
     std::string name_;
-    std::string stateMutability_;
-    nlohmann::json abiMethod_;
     web3::eth::RPC& rpc_;
 
-    std::vector<std::string> encoded_parameters_;
+    abi::Value::Array params_;
 };
 
 class Contract
 {
    public:
+    // The ABI is compiled here, once, and shared by every method call.
     Contract(const std::string& address, const nlohmann::json& abi,
              web3::eth::RPC& rpc);
 
     ContractMethod method(const ::std::string& name);
 
+    const abi::Interface& abi() const
+    {
+        return *abi_;
+    }
+
     static std::string deploy(const nlohmann::json& abi,
                               const std::string& bytecode,
-                              const std::string& from, web3::eth::RPC& rpc);
+                              const std::string& from, web3::eth::RPC& rpc,
+                              const abi::Value::Array& args = {});
 
     std::string address() const;
 
    private:
     std::string address_;
-    nlohmann::json abi_;
+    std::shared_ptr<const abi::Interface> abi_;
     web3::eth::RPC& rpc;
 };
 
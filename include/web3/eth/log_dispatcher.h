@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eth/abi.h"
+#include "types/native.h"
+#include "types/response.h"
+#include "utils/keccak.h"
+
+namespace web3::eth
+{
+
+/**
+ * @brief Routes logs to handlers registered per (contract, event) pair.
+ *
+ * Routes live in an open-addressing table keyed by topic0 and address, so
+ * a log costs one probe (two if some route takes any address) and only
+ * logs that match a route are decoded. Register every route before
+ * dispatching; dispatch() itself is const and may run on several threads.
+ */
+class LogDispatcher
+{
+   public:
+    using Handler = std::function<void(const abi::LogView&)>;
+
+    // Calls handler for every log of event from contract; a zero address
+    // takes logs from any contract. Logs whose topic count differs from
+    // the event's are skipped, as with ERC-20 and ERC-721 Transfer, which
+    // share topic0. Anonymous events have no topic0 and are rejected.
+    void on(const type::address& contract, const abi::Event& event,
+            Handler handler);
+
+    void on(const type::address& contract, const abi::Interface& abi,
+            const std::string& event, Handler handler);
+
+    // Routes to an event struct generated by web3-abigen.
+    template <typename Event>
+    void on(const type::address& contract,
+            std::function<void(const Event&)> handler)
+    {
+        route(contract, Event::topic0,
+              [handler = std::move(handler)](const abi::RawLog& log)
+              {
+                  if (!Event::matches(log))
+                      return false;
+                  handler(Event::decode(log));
+                  return true;
+              });
+    }
+
+    // Each returns the number of handlers the log was passed to.
+    size_t dispatch(const abi::RawLog& log) const;
+    // Only decodes more than topic0 and the address once a route matches.
+    size_t dispatch(const type::response::Log& log) const;
+    size_t dispatch(const std::vector<type::response::Log>& logs) const;
+
+    size_t size() const
+    {
+        return routes_;
+    }
+
+   private:
+    // Returns false if the log turned out not to be its event.
+    using Route = std::function<bool(const abi::RawLog&)>;
+
+    struct Slot
+    {
+        bool used = false;
+        utils::Hash256 topic0{};
+        type::address address;
+        std::vector<Route> routes;
+    };
+
+    void route(const type::address& contract, const utils::Hash256& topic0,
+               Route route);
+    const Slot* find(const utils::Hash256& topic0,
+                     const type::address& address) const;
+    static size_t hash(const utils::Hash256& topic0,
+                       const type::address& address);
+
+    std::vector<Slot> slots_;
+    size_t used_ = 0;
+    size_t routes_ = 0;
+    // Whether any route takes logs from any contract.
+    bool wildcard_ = false;
+};
+
+}  // namespace web3::eth
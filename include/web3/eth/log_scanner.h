@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include "eth/rpc.h"
+#include "types/request.h"
+#include "types/response.h"
+
+namespace web3::eth
+{
+
+struct LogScanOptions
+{
+    // eth_getLogs requests in flight at once.
+    size_t workers = 4;
+    // Blocks per request; adapted as results come in.
+    uint64_t initialChunk = 2'000;
+    uint64_t minChunk = 1;
+    uint64_t maxChunk = 100'000;
+    // Logs per request the chunk size is steered towards.
+    size_t targetLogs = 2'000;
+    // Ranges fetched ahead of the one being delivered, in flight or waiting.
+    // Bounds memory whatever the size of the scan.
+    size_t maxPending = 16;
+    // Retries of a range failing with anything but a limit error.
+    size_t retries = 2;
+};
+
+/**
+ * @brief Fetches the logs of a block range with concurrent eth_getLogs
+ * requests.
+ *
+ * The range is cut into chunks that grow while requests come back small and
+ * shrink when they come back large. A chunk rejected for returning too much
+ * (LIMITEXCEEDED and the like) at least halves the chunk size and is fetched
+ * again in smaller pieces. Logs are handed to the callback in block order on
+ * the calling thread. The connector must allow concurrent requests.
+ */
+class LogScanner
+{
+   public:
+    // Logs of blocks [from, to], in order. The handler may move them out.
+    using Handler = std::function<void(std::vector<type::response::Log>& logs,
+                                       uint64_t from, uint64_t to)>;
+
+    explicit LogScanner(RPC& rpc, LogScanOptions options = {})
+        : rpc_{rpc}, options_{options}
+    {
+    }
+
+    // Scans blocks [from, to] for logs matching filter's addresses and
+    // topics; its block fields are ignored. Returns the number of logs.
+    // Rethrows the first error, from a request or from the handler, after
+    // the requests in flight have finished.
+    uint64_t scan(const type::request::LogFilter& filter, uint64_t from,
+                  uint64_t to, const Handler& handler);
+
+    // Returns true for errors meaning a request asked for too much.
+    static bool isLimitError(const std::exception& error);
+
+   private:
+    RPC& rpc_;
+    LogScanOptions options_;
+};
+
+}  // namespace web3::eth
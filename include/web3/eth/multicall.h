@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eth/contract.h"
+#include "eth/rpc.h"
+#include "types/native.h"
+
+namespace web3::eth
+{
+
+struct MulticallLimits
+{
+    // Calldata of one aggregate3 call, in bytes.
+    size_t calldata = 128 * 1024;
+    // Sum of the gas estimates of the calls in one aggregate3 call; keep it
+    // under the node's eth_call gas cap.
+    uint64_t gas = 30'000'000;
+    // Estimate for calls added without one.
+    uint64_t callGas = 200'000;
+};
+
+/**
+ * @brief Collects eth_calls to any number of contracts and makes them
+ * through Multicall3's aggregate3.
+ *
+ * The calls are packed into as few aggregate3 calls as the limits allow,
+ * and those go to the node as one JSON-RPC batch. Every call may fail on
+ * its own; a failing call that does not allow failure reverts its whole
+ * aggregate3 call, and execute() then throws.
+ */
+class Multicall
+{
+   public:
+    // Multicall3 is deployed at this address on most chains.
+    static constexpr const char* defaultAddress =
+        "0xcA11bde05977b3631167028862bE2a173976CA11";
+
+    struct Result
+    {
+        bool success = false;
+        // Return data, or revert data if the call failed.
+        type::bytes data;
+    };
+
+    explicit Multicall(RPC& rpc, MulticallLimits limits = {});
+    Multicall(RPC& rpc, const type::address& contract,
+              MulticallLimits limits = {});
+
+    // Queues a call and returns the index of its result. A gas of zero
+    // takes the limits' callGas.
+    size_t add(const type::address& target, type::bytes data,
+               bool allowFailure = true, uint64_t gas = 0);
+
+    // Queues a contract method with the parameters given so far.
+    size_t add(const std::string& target, const ContractMethod& method,
+               bool allowFailure = true, uint64_t gas = 0);
+
+    // Queues a call struct generated by web3-abigen.
+    template <typename Call,
+              typename = decltype(std::declval<const Call&>().encode())>
+    size_t add(const type::address& target, const Call& call,
+               bool allowFailure = true, uint64_t gas = 0)
+    {
+        return add(target, call.encode(), allowFailure, gas);
+    }
+
+    size_t size() const
+    {
+        return calls_.size();
+    }
+
+    void clear()
+    {
+        calls_.clear();
+    }
+
+    // Calldata of each aggregate3 call the queued calls are packed into.
+    std::vector<type::bytes> encode() const;
+
+    // Makes the queued calls and empties the queue. Results are in the order
+    // the calls were added. If the node fails a request the calls stay
+    // queued.
+    std::vector<Result> execute(const std::string& block = "latest");
+
+   private:
+    struct Pending
+    {
+        type::address target;
+        bool allowFailure;
+        uint64_t gas;
+        type::bytes data;
+    };
+
+    // Where each aggregate3 call starts in calls_; ends with calls_.size().
+    std::vector<size_t> chunks() const;
+    type::bytes encode(size_t begin, size_t end) const;
+
+    RPC& rpc_;
+    type::address contract_;
+    MulticallLimits limits_;
+    std::vector<Pending> calls_;
+};
+
+}  // namespace web3::eth
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "eth/rpc.h"
+#include "types/native.h"
+#include "types/request.h"
+
+namespace web3::eth
+{
+
+struct Account;
+
+/**
+ * @brief Next nonce of one account, shared by every thread sending from it.
+ *
+ * Once seeded, reserve() is a lock-free compare-and-swap, so concurrent
+ * senders each get a distinct nonce without a round trip to the node.
+ *
+ * The count, an unseeded flag and an epoch share one atomic word. Each
+ * invalidation starts a new epoch, so a reservation can only be released or
+ * invalidated against the counter it was taken from, never against one
+ * reseeded in the meantime. Counts are limited to 48 bits.
+ */
+class Nonce
+{
+   public:
+    static constexpr uint64_t unseeded = std::numeric_limits<uint64_t>::max();
+
+    // A nonce taken by reserve() and the epoch it was taken in.
+    struct Reservation
+    {
+        uint64_t value;
+        uint64_t epoch;
+    };
+
+    bool seeded() const
+    {
+        return !(next_.load(std::memory_order_acquire) & unseededFlag);
+    }
+
+    // The next nonce that would be handed out, or unseeded.
+    uint64_t peek() const
+    {
+        uint64_t state = next_.load(std::memory_order_acquire);
+        return state & unseededFlag ? unseeded : state & countMask;
+    }
+
+    // Takes the next nonce. The value is unseeded if the counter has none.
+    Reservation reserve()
+    {
+        uint64_t state = next_.load(std::memory_order_acquire);
+        while (!(state & unseededFlag) &&
+               !next_.compare_exchange_weak(state, state + 1,
+                                            std::memory_order_acq_rel))
+        {
+        }
+        return {state & unseededFlag ? unseeded : state & countMask,
+                epochOf(state)};
+    }
+
+    // Gives back a nonce that was never sent, provided nothing was reserved
+    // after it and the counter was not reset since. Returns false if that is
+    // no longer possible.
+    bool release(const Reservation& taken)
+    {
+        uint64_t expected = pack(taken.epoch, taken.value + 1);
+        return next_.compare_exchange_strong(
+            expected, pack(taken.epoch, taken.value),
+            std::memory_order_acq_rel);
+    }
+
+    // Sets the counter unless another thread already did. The value is
+    // raised to the floor left by invalidate(), if any.
+    void seed(uint64_t value)
+    {
+        if (value > countMask)
+            throw std::out_of_range("Nonce: count exceeds 48 bits");
+        uint64_t state = next_.load(std::memory_order_acquire);
+        while (state & unseededFlag &&
+               !next_.compare_exchange_weak(
+                   state,
+                   pack(epochOf(state), std::max(value, state & countMask)),
+                   std::memory_order_acq_rel))
+        {
+        }
+    }
+
+    // Forgets the counter; the next reservation reseeds from the node.
+    void invalidate()
+    {
+        uint64_t state = next_.load(std::memory_order_acquire);
+        while (!next_.compare_exchange_weak(state, reset(state, false),
+                                            std::memory_order_acq_rel))
+        {
+        }
+    }
+
+    // As invalidate(), but only while the counter is still in the epoch
+    // `taken` came from. With keepCount the reseeded value will not be lower
+    // than the count at this point. Returns false if another thread reset
+    // the counter first.
+    bool invalidate(const Reservation& taken, bool keepCount)
+    {
+        uint64_t state = next_.load(std::memory_order_acquire);
+        while (epochOf(state) == taken.epoch && !(state & unseededFlag))
+        {
+            if (next_.compare_exchange_weak(state, reset(state, keepCount),
+                                            std::memory_order_acq_rel))
+                return true;
+        }
+        return false;
+    }
+
+   private:
+    friend class NonceManager;
+
+    static constexpr uint64_t unseededFlag = uint64_t(1) << 63;
+    static constexpr int epochShift = 48;
+    static constexpr uint64_t countMask = (uint64_t(1) << epochShift) - 1;
+    static constexpr uint64_t epochMask = (uint64_t(1) << 15) - 1;
+
+    static uint64_t epochOf(uint64_t state)
+    {
+        return (state >> epochShift) & epochMask;
+    }
+
+    static uint64_t pack(uint64_t epoch, uint64_t count)
+    {
+        return epoch << epochShift | (count & countMask);
+    }
+
+    // Unseeded state of the next epoch; the count kept is the reseed floor.
+    static uint64_t reset(uint64_t state, bool keepCount)
+    {
+        uint64_t floor = keepCount && !(state & unseededFlag)
+                             ? state & countMask
+                             : 0;
+        return unseededFlag | pack((epochOf(state) + 1) & epochMask, floor);
+    }
+
+    std::atomic<uint64_t> next_{unseededFlag};
+    std::mutex seeding_;
+};
+
+/**
+ * @brief Hands out nonces from the accounts' local counters.
+ *
+ * A counter is seeded from the node's pending transaction count the first
+ * time it is used, and again after resync(). Only seeding talks to the node
+ * or takes a lock. After "nonce too low" the reseeded count never goes
+ * below the local one, since a node that has not seen our own pending
+ * transactions yet would hand the same nonces out again.
+ */
+class NonceManager
+{
+   public:
+    explicit NonceManager(RPC& rpc) : rpc_{rpc}
+    {
+    }
+
+    uint64_t next(const Account& account);
+
+    // Drops the local count, e.g. after a transaction was dropped from the
+    // mempool, so the next nonce comes from the node again.
+    void resync(const Account& account);
+
+    // Returns true for the node errors that mean the local count is wrong.
+    static bool isNonceError(const std::exception& error);
+
+    // Reserves a nonce for tx, signs it with the account's key and sends it,
+    // returning the transaction hash. On a nonce error the account is
+    // resynced and the send retried once. On other errors the nonce is
+    // reused only if the node refused the transaction; after a transport
+    // failure the account is resynced instead.
+    std::string sendTransaction(const Account& account,
+                                type::request::Transaction tx);
+
+   private:
+    Nonce::Reservation reserve(const Account& account);
+
+    RPC& rpc_;
+};
+
+}  // namespace web3::eth
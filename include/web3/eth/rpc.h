@@ -3,9 +3,12 @@
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "core/client.h"
-#include "core/connector.h"
+#include "core/iconnector.h"
+#include "core/serializer.h"
+#include "types/lazy_block.h"
 #include "types/request.h"
 #include "types/response.h"
 
@@ -15,7 +18,7 @@ namespace web3::eth
 class RPC
 {
    public:
-    explicit RPC(rpc::HTTPClient& connector)
+    explicit RPC(rpc::IConnector& connector)
         : connector_{connector}, client_{rpc::JsonRPCClient(connector)}
     {
     }
@@ -24,8 +27,18 @@ class RPC
     std::string chainId();
     std::string gasPrice();
 
-    std::optional<type::response::Block> getBlockByNumber(uint64_t number);
+    // Blocks, transactions, receipts and logs are read straight from the
+    // response text, without a JSON DOM in between. With full set, the
+    // block's transactions are filled in instead of their hashes.
+    std::optional<type::response::Block> getBlockByNumber(uint64_t number,
+                                                          bool full = false);
     std::optional<type::response::Block> getBlockByHash(
+        const std::string& hash, bool full = false);
+    // Fetch blocks with full transactions but only index the response;
+    // header fields and transactions are decoded when first read.
+    std::optional<type::response::LazyBlock> getLazyBlockByNumber(
+        uint64_t number);
+    std::optional<type::response::LazyBlock> getLazyBlockByHash(
         const std::string& hash);
 
     std::optional<std::string> getBlockTransactionCountByNumber(
@@ -37,16 +50,33 @@ class RPC
         const std::string& hash);
     std::optional<type::response::Receipt> getTransactionReceipt(
         const std::string& hash);
+    // Fetches all receipts in a single JSON-RPC batch round trip.
+    std::vector<std::optional<type::response::Receipt>> getTransactionReceipts(
+        const std::vector<std::string>& hashes);
 
     std::string getBalance(const type::request::Address& s);
     std::string getTransactionCount(const type::request::Address& s);
 
+    // eth_call; returns the hex return data.
+    std::string call(const type::request::Call& call,
+                     const std::string& block = "latest");
+    // Several eth_calls in one JSON-RPC batch round trip; each result fails
+    // on its own.
+    std::vector<rpc::BatchResult<std::string>> callBatch(
+        const std::vector<type::request::Call>& calls,
+        const std::string& block = "latest");
+    // eth_sendTransaction, signed by the node; returns the transaction hash.
+    std::string sendTransaction(const type::request::Call& call);
+
+    std::vector<type::response::Log> getLogs(
+        const type::request::LogFilter& filter);
+
     std::string estimateGas(const type::request::Transaction& t);
     std::string sendRawTransaction(const std::string& signedTx);
 
    protected:
     rpc::JsonRPCClient client_;
-    rpc::HTTPClient& connector_;
+    rpc::IConnector& connector_;
 };
 
 }  // namespace web3::eth
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "core/stream.h"
+#include "types/request.h"
+#include "types/response.h"
+
+namespace web3::eth
+{
+
+/**
+ * @brief Typed eth_subscribe streams over a WebSocket or IPC connector.
+ *
+ * Handlers run on the connector's reader thread and must not block. Each
+ * subscribe call returns the node's subscription id for unsubscribe().
+ */
+class Subscriptions
+{
+   public:
+    explicit Subscriptions(rpc::StreamConnector& connector);
+
+    std::string newHeads(
+        std::function<void(const type::response::Block&)> handler);
+    std::string logs(const type::request::LogFilter& filter,
+                     std::function<void(const type::response::Log&)> handler);
+    std::string newPendingTransactions(
+        std::function<void(const std::string& hash)> handler);
+
+    bool unsubscribe(const std::string& subscriptionId);
+
+   private:
+    rpc::StreamConnector& connector_;
+};
+
+}  // namespace web3::eth
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "types/native.h"
+#include "types/response.h"
+
+namespace web3::type::compact
+{
+
+using Hash = std::array<uint8_t, 32>;
+using Bloom = std::array<uint8_t, 256>;
+
+// Decoders for the hex strings of the JSON-RPC API. An empty string, which
+// the response types hold for absent fields, decodes to zero. Text that is
+// not hex or does not fit throws std::invalid_argument.
+uint64_t parseU64(std::string_view hex);
+uint256 parseU256(std::string_view hex);
+Hash parseHash(std::string_view hex);
+Bloom parseBloom(std::string_view hex);
+address parseAddress(std::string_view hex);
+bytes parseBytes(std::string_view hex);
+
+struct AccessList
+{
+    type::address address;
+    std::vector<Hash> storageKeys = {};
+};
+
+struct Transaction
+{
+    Hash blockHash = {};
+    uint64_t blockNumber = 0;
+    type::address from;
+    uint64_t transactionIndex = 0;
+    uint8_t type = 0;
+    uint64_t nonce = 0;
+    // Empty for contract creations.
+    std::optional<type::address> to;
+    uint64_t gas = 0;
+    uint256 value;
+    bytes input;
+    uint256 maxPriorityFeePerGas;
+    uint256 maxFeePerGas;
+    uint256 maxFeePerBlobGas;
+    uint256 gasPrice;
+    std::vector<AccessList> accessList = {};
+    std::vector<Hash> blobVersionedHashes = {};
+    uint64_t chainId = 0;
+    uint8_t yParity = 0;
+    uint256 r;
+    uint256 s;
+    uint64_t v = 0;
+};
+
+struct Withdrawal
+{
+    uint64_t index = 0;
+    uint64_t validatorIndex = 0;
+    type::address address;
+    // In gwei.
+    uint64_t amount = 0;
+};
+
+struct Block
+{
+    Hash hash = {};
+    Hash parentHash = {};
+    Hash sha3Uncles = {};
+    type::address miner;
+    Hash stateRoot = {};
+    Hash transactionsRoot = {};
+    Hash receiptsRoot = {};
+    Bloom logsBloom = {};
+    uint256 difficulty;
+    uint64_t number = 0;
+    uint64_t gasLimit = 0;
+    uint64_t gasUsed = 0;
+    uint64_t timestamp = 0;
+    bytes extraData;
+    Hash mixHash = {};
+    uint64_t nonce = 0;
+    uint256 baseFeePerGas;
+    Hash withdrawalsRoot = {};
+    uint64_t size = 0;
+    std::vector<Transaction> transactions = {};
+    std::vector<Hash> transactionHashes = {};
+    std::vector<Withdrawal> withdrawals = {};
+    std::vector<Hash> uncles = {};
+};
+
+struct Log
+{
+    bool removed = false;
+    uint64_t logIndex = 0;
+    uint64_t transactionIndex = 0;
+    Hash transactionHash = {};
+    Hash blockHash = {};
+    uint64_t blockNumber = 0;
+    uint64_t blockTimestamp = 0;
+    type::address address;
+    bytes data;
+    std::vector<Hash> topics = {};
+};
+
+struct Receipt
+{
+    uint8_t type = 0;
+    Hash transactionHash = {};
+    uint64_t transactionIndex = 0;
+    Hash blockHash = {};
+    uint64_t blockNumber = 0;
+    type::address from;
+    // Empty for contract creations.
+    std::optional<type::address> to;
+    uint64_t cumulativeGasUsed = 0;
+    uint64_t gasUsed = 0;
+    uint64_t blobGasUsed = 0;
+    std::optional<type::address> contractAddress;
+    Bloom logsBloom = {};
+    // Pre-Byzantium receipts carry a state root instead of a status.
+    Hash root = {};
+    uint8_t status = 0;
+    uint256 effectiveGasPrice;
+    uint256 blobGasPrice;
+};
+
+// Decode the hex string fields of a response type into its compact
+// counterpart.
+AccessList fromResponse(const response::AccessList& a);
+Transaction fromResponse(const response::Transaction& t);
+Withdrawal fromResponse(const response::Withdrawal& w);
+Block fromResponse(const response::Block& b);
+Log fromResponse(const response::Log& l);
+Receipt fromResponse(const response::Receipt& r);
+
+inline void from_json(const nlohmann::json& j, Transaction& t)
+{
+    t = fromResponse(j.get<response::Transaction>());
+}
+
+inline void from_json(const nlohmann::json& j, Block& b)
+{
+    b = fromResponse(j.get<response::Block>());
+}
+
+inline void from_json(const nlohmann::json& j, Log& l)
+{
+    l = fromResponse(j.get<response::Log>());
+}
+
+inline void from_json(const nlohmann::json& j, Receipt& r)
+{
+    r = fromResponse(j.get<response::Receipt>());
+}
+
+}  // namespace web3::type::compact
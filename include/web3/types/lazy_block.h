@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types/compact.h"
+#include "types/response_reader.h"
+
+namespace web3::type::response
+{
+
+/**
+ * @brief A block response kept as text and decoded on demand.
+ *
+ * load() walks the text once to index the offsets of the header fields and
+ * of each transaction; nothing is decoded until it is asked for. A
+ * transaction is decoded on its first access and cached. Accessors are not
+ * safe to call from several threads at once.
+ */
+class LazyBlock
+{
+   public:
+    LazyBlock() = default;
+    LazyBlock(LazyBlock&&) = default;
+    LazyBlock& operator=(LazyBlock&&) = default;
+
+    // Takes the text of an eth_getBlockBy* response and indexes its result.
+    // On Error, text() still returns the response so it can be reported.
+    ReadStatus load(std::string response);
+
+    // The whole response text.
+    const std::string& text() const
+    {
+        return text_;
+    }
+
+    // The raw text of a header field without quotes, or an empty view if
+    // the block has no such field or it is null.
+    std::string_view field(std::string_view name) const;
+
+    uint64_t number() const
+    {
+        return compact::parseU64(field("number"));
+    }
+
+    compact::Hash hash() const
+    {
+        return compact::parseHash(field("hash"));
+    }
+
+    compact::Hash parentHash() const
+    {
+        return compact::parseHash(field("parentHash"));
+    }
+
+    uint64_t timestamp() const
+    {
+        return compact::parseU64(field("timestamp"));
+    }
+
+    // Every header field, with transactionHashes filled for blocks fetched
+    // without full transactions; transactions is left empty.
+    compact::Block header() const;
+
+    // Full transactions, or hashes for blocks fetched without them.
+    size_t transactionCount() const
+    {
+        return transactions_.size();
+    }
+
+    bool fullTransactions() const
+    {
+        return full_;
+    }
+
+    // The raw text of transaction i.
+    std::string_view transactionText(size_t i) const;
+
+    // Decodes transaction i on first access. Throws std::out_of_range for
+    // a bad index and std::runtime_error for a block without full
+    // transactions or a malformed transaction.
+    const compact::Transaction& transaction(size_t i) const;
+
+    // Hash of transaction i of a block fetched without full transactions.
+    compact::Hash transactionHash(size_t i) const;
+
+   private:
+    struct Span
+    {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    struct Field
+    {
+        Span key;
+        Span value;
+    };
+
+    std::string_view view(Span span) const
+    {
+        return std::string_view(text_).substr(span.begin,
+                                              span.end - span.begin);
+    }
+
+    std::string text_;
+    std::vector<Field> fields_;
+    std::vector<Span> transactions_;
+    bool full_ = false;
+    mutable std::vector<std::unique_ptr<compact::Transaction>> decoded_;
+};
+
+}  // namespace web3::type::response
@@ -1,142 +1,456 @@
 #pragma once
-#include <gmpxx.h>
 
 #include <array>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace web3::type
 {
 
+/**
+ * @brief 256-bit unsigned integer stored as four 64-bit limbs.
+ *
+ * Arithmetic operators wrap modulo 2^256 like the EVM does, and division or
+ * modulo by zero yields zero. The checked* variants throw instead.
+ */
 class uint256
 {
    public:
-    mpz_class v;
+    // Least significant limb first.
+    std::array<uint64_t, 4> limbs;
 
-    uint256() : v(0)
+    constexpr uint256() : limbs{0, 0, 0, 0}
     {
     }
-    uint256(uint64_t x)
+    constexpr uint256(uint64_t x) : limbs{x, 0, 0, 0}
     {
-        mpz_set_ui(v.get_mpz_t(), x);
     }
-    uint256(uint8_t x)
+    // Accepts base 10 or 16; a "0x" prefix always selects base 16 and an
+    // empty string is zero.
+    uint256(const std::string& s, int base = 10) : uint256(parse(s, base))
     {
-        mpz_set_ui(v.get_mpz_t(), x);
     }
-    uint256(const std::string& s, int base = 10) : v(s, base)
+
+    static constexpr uint256 parse(std::string_view s, int base = 10)
     {
+        uint256 r;
+        size_t pos = 0;
+        if (s.size() >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+        {
+            base = 16;
+            pos = 2;
+        }
+        if (base != 10 && base != 16)
+            throw std::invalid_argument("uint256: unsupported base");
+
+        for (; pos < s.size(); pos++)
+        {
+            int d = digitValue(s[pos]);
+            if (d >= base)
+                throw std::invalid_argument("uint256: invalid digit in " +
+                                            std::string(s));
+            if (r.mulAdd(base, d))
+                throw std::out_of_range("uint256: value out of range: " +
+                                        std::string(s));
+        }
+        return r;
     }
-    uint256(const mpz_class& x) : v(x)
+
+    // Big-endian, at most 32 bytes.
+    static uint256 fromBytes(const uint8_t* data, size_t size);
+
+    std::array<uint8_t, 32> toBytes() const;
+
+    std::string toHex() const;
+
+    std::string toDec() const;
+
+    constexpr uint64_t toU64() const
     {
+        return limbs[0];
     }
 
-    std::string toHex() const
+    constexpr bool isZero() const
     {
-        return "0x" + v.get_str(16);
+        return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0;
     }
 
-    std::string toDec() const
+    // Number of significant bits, 0 for zero.
+    constexpr size_t bitLength() const
     {
-        return v.get_str(10);
+        for (size_t i = 4; i-- > 0;)
+            if (limbs[i])
+                return i * 64 + 64 - __builtin_clzll(limbs[i]);
+        return 0;
     }
 
-    uint64_t toU64() const
+    // Length of the minimal big-endian encoding, 0 for zero.
+    constexpr size_t byteLength() const
     {
-        return v.get_ui();
+        return (bitLength() + 7) / 8;
     }
 
-    uint256 operator+(const uint256& o) const
+    // Wrapping arithmetic
+    constexpr uint256 operator+(const uint256& o) const
     {
-        mpz_class x = v + o.v;
-        return uint256(x.get_str());
+        uint256 r(*this);
+        r += o;
+        return r;
     }
 
-    uint256 operator-(const uint256& o) const
+    constexpr uint256 operator-(const uint256& o) const
     {
-        if (o.v > v)
-            throw std::runtime_error("uint256 underflow");
-        mpz_class x = v - o.v;
-        return uint256(x.get_str());
+        uint256 r(*this);
+        r -= o;
+        return r;
     }
 
-    uint256 operator*(const uint256& o) const
+    constexpr uint256 operator*(const uint256& o) const
     {
-        mpz_class x = v * o.v;
-        return uint256(x.get_str());
+        uint256 r;
+        for (size_t i = 0; i < 4; i++)
+        {
+            unsigned __int128 carry = 0;
+            for (size_t j = 0; i + j < 4; j++)
+            {
+                unsigned __int128 t =
+                    static_cast<unsigned __int128>(limbs[i]) * o.limbs[j] +
+                    r.limbs[i + j] + carry;
+                r.limbs[i + j] = static_cast<uint64_t>(t);
+                carry = t >> 64;
+            }
+        }
+        return r;
     }
 
-    uint256 operator/(const uint256& o) const
+    constexpr uint256 operator/(const uint256& o) const
     {
-        mpz_class x = v / o.v;
-        return uint256(x.get_str());
+        uint256 q, r;
+        divmod(*this, o, q, r);
+        return q;
     }
 
-    uint256 operator%(const uint256& o) const
+    constexpr uint256 operator%(const uint256& o) const
     {
-        mpz_class x = v % o.v;
-        return uint256(x.get_str());
+        uint256 q, r;
+        divmod(*this, o, q, r);
+        return r;
     }
 
-    uint256& operator+=(const uint256& o)
+    constexpr uint256& operator+=(const uint256& o)
     {
-        v += o.v;
+        unsigned __int128 carry = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            carry += static_cast<unsigned __int128>(limbs[i]) + o.limbs[i];
+            limbs[i] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
         return *this;
     }
 
-    uint256& operator-=(const uint256& o)
+    constexpr uint256& operator-=(const uint256& o)
     {
-        if (o.v > v)
-            throw std::runtime_error("uint256 underflow");
-        v -= o.v;
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            uint64_t a = limbs[i];
+            uint64_t d = a - o.limbs[i] - borrow;
+            borrow = (a < o.limbs[i]) || (a - o.limbs[i] < borrow);
+            limbs[i] = d;
+        }
         return *this;
     }
 
+    constexpr uint256& operator*=(const uint256& o)
+    {
+        return *this = *this * o;
+    }
+
+    constexpr uint256& operator/=(const uint256& o)
+    {
+        return *this = *this / o;
+    }
+
+    constexpr uint256& operator%=(const uint256& o)
+    {
+        return *this = *this % o;
+    }
+
+    // Checked arithmetic
+    constexpr uint256 checkedAdd(const uint256& o) const
+    {
+        uint256 r = *this + o;
+        if (r < *this)
+            throw std::overflow_error("uint256 overflow");
+        return r;
+    }
+
+    constexpr uint256 checkedSub(const uint256& o) const
+    {
+        if (o > *this)
+            throw std::underflow_error("uint256 underflow");
+        return *this - o;
+    }
+
+    constexpr uint256 checkedMul(const uint256& o) const
+    {
+        size_t width = bitLength() + o.bitLength();
+        uint256 r = *this * o;
+        // A product of an m-bit and an n-bit value has m+n-1 or m+n bits.
+        if (width > 257 || (width == 257 && r / o != *this))
+            throw std::overflow_error("uint256 overflow");
+        return r;
+    }
+
+    constexpr uint256 checkedDiv(const uint256& o) const
+    {
+        if (o.isZero())
+            throw std::domain_error("uint256 division by zero");
+        return *this / o;
+    }
+
+    constexpr uint256 checkedMod(const uint256& o) const
+    {
+        if (o.isZero())
+            throw std::domain_error("uint256 division by zero");
+        return *this % o;
+    }
+
+    // Quotient and remainder in one pass; both are zero when d is zero.
+    static constexpr void divmod(const uint256& n, const uint256& d,
+                                 uint256& q, uint256& r)
+    {
+        q = uint256();
+        r = uint256();
+        if (d.isZero())
+            return;
+        if (n < d)
+        {
+            r = n;
+            return;
+        }
+
+        size_t dn = 4;
+        while (d.limbs[dn - 1] == 0)
+            dn--;
+        if (dn == 1)
+        {
+            q = n;
+            r.limbs[0] = q.divSmall(d.limbs[0]);
+            return;
+        }
+
+        // Knuth, TAOCP vol. 2, 4.3.1, algorithm D with 64-bit digits.
+        size_t nn = 4;
+        while (n.limbs[nn - 1] == 0)
+            nn--;
+        int s = __builtin_clzll(d.limbs[dn - 1]);
+
+        uint64_t v[4] = {};
+        uint64_t u[5] = {};
+        for (size_t i = dn; i-- > 0;)
+            v[i] =
+                (d.limbs[i] << s) | (s && i ? d.limbs[i - 1] >> (64 - s) : 0);
+        u[nn] = s ? n.limbs[nn - 1] >> (64 - s) : 0;
+        for (size_t i = nn; i-- > 0;)
+            u[i] =
+                (n.limbs[i] << s) | (s && i ? n.limbs[i - 1] >> (64 - s) : 0);
+
+        using u128 = unsigned __int128;
+        for (size_t j = nn - dn + 1; j-- > 0;)
+        {
+            u128 num = (static_cast<u128>(u[j + dn]) << 64) | u[j + dn - 1];
+            u128 qhat = num / v[dn - 1];
+            u128 rhat = num % v[dn - 1];
+            while (qhat >> 64 ||
+                   qhat * v[dn - 2] > ((rhat << 64) | u[j + dn - 2]))
+            {
+                qhat--;
+                rhat += v[dn - 1];
+                if (rhat >> 64)
+                    break;
+            }
+
+            // Multiply and subtract.
+            u128 carry = 0;
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < dn; i++)
+            {
+                u128 p = qhat * v[i] + carry;
+                carry = p >> 64;
+                uint64_t lo = static_cast<uint64_t>(p);
+                uint64_t t = u[i + j] - lo - borrow;
+                borrow = (u[i + j] < lo) || (u[i + j] - lo < borrow);
+                u[i + j] = t;
+            }
+            uint64_t top = u[j + dn];
+            uint64_t c = static_cast<uint64_t>(carry);
+            u[j + dn] = top - c - borrow;
+            bool negative = (top < c) || (top - c < borrow);
+
+            if (negative)
+            {
+                // qhat was one too large, add the divisor back.
+                qhat--;
+                u128 sum = 0;
+                for (size_t i = 0; i < dn; i++)
+                {
+                    sum += static_cast<u128>(u[i + j]) + v[i];
+                    u[i + j] = static_cast<uint64_t>(sum);
+                    sum >>= 64;
+                }
+                u[j + dn] += static_cast<uint64_t>(sum);
+            }
+            q.limbs[j] = static_cast<uint64_t>(qhat);
+        }
+
+        for (size_t i = 0; i < dn; i++)
+            r.limbs[i] = (u[i] >> s) | (s ? u[i + 1] << (64 - s) : 0);
+    }
+
     // shifts
-    uint256 operator<<(size_t c) const
+    constexpr uint256 operator<<(size_t c) const
+    {
+        uint256 r;
+        if (c >= 256)
+            return r;
+        size_t words = c / 64, bits = c % 64;
+        for (size_t i = 4; i-- > words;)
+        {
+            uint64_t v = limbs[i - words] << bits;
+            if (bits && i > words)
+                v |= limbs[i - words - 1] >> (64 - bits);
+            r.limbs[i] = v;
+        }
+        return r;
+    }
+
+    constexpr uint256 operator>>(size_t c) const
+    {
+        uint256 r;
+        if (c >= 256)
+            return r;
+        size_t words = c / 64, bits = c % 64;
+        for (size_t i = 0; i + words < 4; i++)
+        {
+            uint64_t v = limbs[i + words] >> bits;
+            if (bits && i + words < 3)
+                v |= limbs[i + words + 1] << (64 - bits);
+            r.limbs[i] = v;
+        }
+        return r;
+    }
+
+    constexpr uint256& operator<<=(size_t c)
     {
-        mpz_class r;
-        mpz_mul_2exp(r.get_mpz_t(), v.get_mpz_t(), c);
-        return uint256(r.get_str());
+        return *this = *this << c;
     }
 
-    uint256 operator>>(size_t c) const
+    constexpr uint256& operator>>=(size_t c)
     {
-        mpz_class r;
-        mpz_div_2exp(r.get_mpz_t(), v.get_mpz_t(), c);
-        return uint256(r.get_str());
+        return *this = *this >> c;
     }
 
     // comparisons
-    bool operator<(const uint256& o) const
+    constexpr bool operator<(const uint256& o) const
     {
-        return v < o.v;
+        for (size_t i = 4; i-- > 0;)
+            if (limbs[i] != o.limbs[i])
+                return limbs[i] < o.limbs[i];
+        return false;
     }
-    bool operator>(const uint256& o) const
+    constexpr bool operator>(const uint256& o) const
     {
-        return v > o.v;
+        return o < *this;
     }
-    bool operator<=(const uint256& o) const
+    constexpr bool operator<=(const uint256& o) const
     {
-        return v <= o.v;
+        return !(o < *this);
     }
-    bool operator>=(const uint256& o) const
+    constexpr bool operator>=(const uint256& o) const
     {
-        return v >= o.v;
+        return !(*this < o);
     }
-    bool operator==(const uint256& o) const
+    constexpr bool operator==(const uint256& o) const
     {
-        return v == o.v;
+        return limbs[0] == o.limbs[0] && limbs[1] == o.limbs[1] &&
+               limbs[2] == o.limbs[2] && limbs[3] == o.limbs[3];
     }
-    bool operator!=(const uint256& o) const
+    constexpr bool operator!=(const uint256& o) const
+    {
+        return !(*this == o);
+    }
+
+    // bitwise
+    constexpr uint256 operator&(const uint256& o) const
+    {
+        uint256 r;
+        for (size_t i = 0; i < 4; i++)
+            r.limbs[i] = limbs[i] & o.limbs[i];
+        return r;
+    }
+    constexpr uint256 operator|(const uint256& o) const
+    {
+        uint256 r;
+        for (size_t i = 0; i < 4; i++)
+            r.limbs[i] = limbs[i] | o.limbs[i];
+        return r;
+    }
+    constexpr uint256 operator^(const uint256& o) const
+    {
+        uint256 r;
+        for (size_t i = 0; i < 4; i++)
+            r.limbs[i] = limbs[i] ^ o.limbs[i];
+        return r;
+    }
+    constexpr uint256 operator~() const
+    {
+        uint256 r;
+        for (size_t i = 0; i < 4; i++)
+            r.limbs[i] = ~limbs[i];
+        return r;
+    }
+
+   private:
+    static constexpr int digitValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return 99;
+    }
+
+    // *this = *this * m + a, returns the carry out of the top limb.
+    constexpr uint64_t mulAdd(uint64_t m, uint64_t a)
     {
-        return v != o.v;
+        unsigned __int128 carry = a;
+        for (size_t i = 0; i < 4; i++)
+        {
+            carry += static_cast<unsigned __int128>(limbs[i]) * m;
+            limbs[i] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        return static_cast<uint64_t>(carry);
     }
 
-    uint256 operator&(const uint256 o) const
+    // Divides in place by d, returns the remainder.
+    constexpr uint64_t divSmall(uint64_t d)
     {
-        mpz_class x = v & o.v;
-        return uint256(x.get_str());
+        unsigned __int128 rem = 0;
+        for (size_t i = 4; i-- > 0;)
+        {
+            unsigned __int128 cur = (rem << 64) | limbs[i];
+            limbs[i] = static_cast<uint64_t>(cur / d);
+            rem = cur % d;
+        }
+        return static_cast<uint64_t>(rem);
     }
 };
 
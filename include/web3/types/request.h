@@ -6,13 +6,14 @@
 #include <string>
 
 #include "types/native.h"
+#include "utils/hex.h"
 
 namespace web3::type::request
 {
 
 struct Transaction
 {
-    uint8_t type;
+    uint8_t type = 0;
     uint256 nonce;
     address to;
     address from;
@@ -28,6 +29,9 @@ struct Transaction
     uint256 chainId;
     std::vector<response::AuthorizationList> authorizationList;
 
+    // Empty legacy transaction, to be filled in field by field.
+    Transaction() = default;
+
     // Legacy Transaction
     Transaction(const uint256& nonce, const uint256& gasPrice,
                 const uint256& gas, const address& to, const address& from,
@@ -135,7 +139,7 @@ struct Transaction
 
 struct Address
 {
-    address address;
+    type::address address;
     std::string block = "latest";
 };
 
@@ -155,7 +159,7 @@ inline void to_json(nlohmann::json& j, const Address& b)
 
 struct Balance
 {
-    address address;
+    type::address address;
     uint256 balance;  // amount of wei
 };
 
@@ -173,4 +177,84 @@ inline void to_json(nlohmann::json& j, const Balance& b)
     put("balance", b.balance.toHex());
 }
 
+struct LogFilter
+{
+    std::vector<type::address> addresses = {};
+    // One entry per topic position; an empty position matches anything and
+    // several values in one position match any of them.
+    std::vector<std::vector<std::string>> topics = {};
+    std::string fromBlock = {};
+    std::string toBlock = {};
+    std::string blockHash = {};
+};
+
+inline void to_json(nlohmann::json& j, const LogFilter& f)
+{
+    j = nlohmann::json::object();
+
+    auto put = [&](const char* key, const std::string& value)
+    {
+        if (!value.empty())
+            j[key] = value;
+    };
+
+    put("fromBlock", f.fromBlock);
+    put("toBlock", f.toBlock);
+    put("blockHash", f.blockHash);
+
+    if (f.addresses.size() == 1)
+        j["address"] = f.addresses[0].toHex();
+    else if (!f.addresses.empty())
+    {
+        j["address"] = nlohmann::json::array();
+        for (const auto& a : f.addresses)
+            j["address"].push_back(a.toHex());
+    }
+
+    if (!f.topics.empty())
+    {
+        j["topics"] = nlohmann::json::array();
+        for (const auto& position : f.topics)
+        {
+            if (position.empty())
+                j["topics"].push_back(nullptr);
+            else if (position.size() == 1)
+                j["topics"].push_back(position[0]);
+            else
+                j["topics"].push_back(position);
+        }
+    }
+}
+
+// Message for eth_call, eth_estimateGas and eth_sendTransaction. Zero
+// values are left out, so the node fills in its defaults; a zero `to`
+// deploys a contract.
+struct Call
+{
+    type::address to;
+    type::address from;
+    bytes data;
+    uint256 gas;
+    uint256 value;
+};
+
+inline void to_json(nlohmann::json& j, const Call& c)
+{
+    j = nlohmann::json::object();
+
+    if (c.to != type::address())
+        j["to"] = c.to.toHex();
+    if (c.from != type::address())
+        j["from"] = c.from.toHex();
+    if (!c.gas.isZero())
+        j["gas"] = c.gas.toHex();
+    if (!c.value.isZero())
+        j["value"] = c.value.toHex();
+
+    std::string data(2 + 2 * c.data.size(), '0');
+    data[1] = 'x';
+    utils::hex::encode(c.data.data(), c.data.size(), &data[2]);
+    j["data"] = std::move(data);
+}
+
 }  // namespace web3::type::request
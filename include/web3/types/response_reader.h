@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "types/response.h"
+
+namespace web3::type::response
+{
+
+enum class ReadStatus
+{
+    // The result was read into the output.
+    Value,
+    // The result was null.
+    Null,
+    // An error response, malformed JSON or a result of the wrong shape; the
+    // caller re-parses the text to report it.
+    Error
+};
+
+// Reads the result of a JSON-RPC response straight from its text with
+// nlohmann's SAX parser, without building a DOM: strings are moved from the
+// parser into the fields and members without a field are skipped. The
+// fields filled match the from_json functions. out must be freshly
+// constructed.
+ReadStatus read(std::string_view response, Block& out);
+ReadStatus read(std::string_view response, Transaction& out);
+ReadStatus read(std::string_view response, Receipt& out);
+ReadStatus read(std::string_view response, std::vector<Log>& out);
+ReadStatus read(std::string_view response, std::vector<Receipt>& out);
+
+// Reads a bare value, such as one transaction of a block's text, rather
+// than the result of a response.
+ReadStatus readValue(std::string_view json, Transaction& out);
+
+}  // namespace web3::type::response
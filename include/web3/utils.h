@@ -1,17 +1,23 @@
 #pragma once
+#include <array>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "types/native.h"
 #include "types/request.h"
 #include "types/response.h"
+#include "utils/rlp.h"
+#include "utils/thread_pool.h"
 
 namespace web3::utils
 {
+// Values are the power of ten of each unit in wei.
 enum class Unit
 {
-    WEI = 1,
+    WEI = 0,
     GWEI = 9,
     ETHER = 18
 };
@@ -19,11 +25,103 @@ enum class Unit
 inline std::map<std::string, Unit> unitMap = {
     {"wei", Unit::WEI}, {"gwei", Unit::GWEI}, {"ether", Unit::ETHER}};
 
+constexpr type::uint256 unitFactor(Unit unit)
+{
+    type::uint256 factor = 1;
+    for (int i = 0; i < static_cast<int>(unit); i++)
+        factor *= 10;
+    return factor;
+}
+
+// Compile-time path, e.g. constexpr auto fee = toWei(30, Unit::GWEI);
+constexpr type::uint256 toWei(const type::uint256& amount, Unit unit)
+{
+    return amount.checkedMul(unitFactor(unit));
+}
+constexpr type::uint256 fromWei(const type::uint256& wei, Unit unit)
+{
+    return wei / unitFactor(unit);
+}
+
 type::uint256 toWei(const web3::type::uint256& amount,
                     const std::string& unit = "ether");
 type::uint256 fromWei(const web3::type::uint256& wei,
                       const std::string& unit = "ether");
 
+// Parses a decimal amount such as "1.5", "2e9" or "1'000" in the given unit,
+// or a plain 0x-prefixed hex integer, into wei. Throws if the result is not a
+// whole number of wei or does not fit in 256 bits.
+constexpr type::uint256 parseAmount(std::string_view text, Unit unit)
+{
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        type::uint256 value;
+        for (size_t i = 2; i < text.size(); i++)
+        {
+            char c = text[i];
+            if (c == '\'')
+                continue;
+            int d = (c >= '0' && c <= '9')   ? c - '0'
+                    : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                    : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                             : -1;
+            if (d < 0)
+                throw std::invalid_argument("Invalid hex amount");
+            if (value.bitLength() > 252)
+                throw std::overflow_error("uint256 overflow");
+            value = (value << 4) | type::uint256(d);
+        }
+        return toWei(value, unit);
+    }
+    if (text.size() > 1 && text[0] == '0' && text[1] >= '0' && text[1] <= '9')
+        throw std::invalid_argument("Octal amounts are not supported");
+
+    type::uint256 value;
+    int scale = static_cast<int>(unit);
+    bool fraction = false;
+    size_t i = 0;
+    for (; i < text.size(); i++)
+    {
+        char c = text[i];
+        if (c == '\'')
+            continue;
+        if (c == '.' && !fraction)
+        {
+            fraction = true;
+            continue;
+        }
+        if (c == 'e' || c == 'E')
+            break;
+        if (c < '0' || c > '9')
+            throw std::invalid_argument("Invalid decimal amount");
+        value = value.checkedMul(10).checkedAdd(c - '0');
+        if (fraction)
+            scale--;
+    }
+
+    if (i < text.size())
+    {
+        int exponent = 0;
+        for (i++; i < text.size(); i++)
+        {
+            if (text[i] < '0' || text[i] > '9' || exponent > 1000)
+                throw std::invalid_argument("Invalid amount exponent");
+            exponent = exponent * 10 + (text[i] - '0');
+        }
+        scale += exponent;
+    }
+
+    for (; scale > 0; scale--)
+        value = value.checkedMul(10);
+    for (; scale < 0; scale++)
+    {
+        if (!(value % 10).isZero())
+            throw std::invalid_argument("Amount is not a whole number of wei");
+        value /= 10;
+    }
+    return value;
+}
+
 // Hex/Bytes Utilities
 bool isHex(const std::string& hex);
 type::bytes hexToBytes(const std::string& hex);
@@ -44,6 +142,8 @@ type::bytes keccak256(const web3::type::bytes& data);
 type::bytes privateKeyToPublicKey(const std::string& privateKey);
 type::address publicKeyToAddress(const type::bytes& publicKey);
 type::address privateKeyToAddress(const std::string& privateKey);
+// A random valid secp256k1 private key, as 0x-prefixed hex.
+std::string generatePrivateKey();
 
 // Signing
 namespace sign
@@ -56,46 +156,35 @@ struct Signature
     uint8_t yParity;
 };
 
-Signature signHash(const std::string& privKey, const type::bytes& hash);
+// A private key parsed and checked once, for callers that sign repeatedly.
+using SecretKey = std::array<uint8_t, 32>;
+SecretKey parseSecretKey(const std::string& privKey);
 
+Signature signHash(const std::string& privKey, const type::bytes& hash);
+Signature signHash(const SecretKey& key, const type::bytes& hash);
+
+// Signs every 32-byte hash with one key, spread across the pool.
+std::vector<Signature> signBatch(const std::string& privKey,
+                                 const std::vector<type::bytes>& hashes,
+                                 ThreadPool& pool = ThreadPool::shared());
+// Signs hashes[i] with privKeys[i].
+std::vector<Signature> signBatch(const std::vector<std::string>& privKeys,
+                                 const std::vector<type::bytes>& hashes,
+                                 ThreadPool& pool = ThreadPool::shared());
+
+// Hex network encoding of a signed legacy or typed transaction.
 std::string buildSignedLegacy(const type::request::Transaction& tx,
                               const Signature& sig);
 std::string buildSignedTyped(const type::request::Transaction& tx,
                              const Signature& sig);
 
-type::bytes signTransaction(const std::vector<type::bytes>& items,
+// Signs tx and returns its network encoding, ready for eth_sendRawTransaction.
+type::bytes signTransaction(const type::request::Transaction& tx,
                             const std::string& privKey);
+type::bytes signTransaction(const type::request::Transaction& tx,
+                            const SecretKey& key);
 }  // namespace sign
 
-// RLP Encoding
-namespace rlp
-{
-
-type::bytes encodeBytes(const type::bytes& bytes);
-type::bytes encodeUint256(const type::uint256& value);
-type::bytes encodeAddress(const type::address& addr);
-type::bytes encodeList(const std::vector<type::bytes>& items);
-type::bytes encodeAccessList(
-    const std::vector<type::response::AccessList>& accessList);
-type::bytes encodeAuthorizationList(
-    const std::vector<type::response::AuthorizationList>& authList);
-
-std::vector<type::bytes> encodeLegacyTransaction(
-    const type::request::Transaction& tx);
-std::vector<type::bytes> encodeEIP2930Transaction(
-    const type::request::Transaction& tx);
-std::vector<type::bytes> encodeEIP1559Transaction(
-    const type::request::Transaction& tx);
-std::vector<type::bytes> encodeEIP4844Transaction(
-    const type::request::Transaction& tx);
-std::vector<type::bytes> encodeEIP7702Transaction(
-    const type::request::Transaction& tx);
-
-std::vector<type::bytes> getEncodedTransactionItems(
-    const type::request::Transaction& tx);
-type::bytes encodeTransactionFromItems(const std::vector<type::bytes>& items);
-}  // namespace rlp
-
 // web3::type::bytes rlpEncode(const web3::type::bytes& input);
 // web3::type::bytes rlpEncodeList(const std::vector<web3::type::bytes>&
 // inputs);
@@ -107,3 +196,49 @@ type::bytes encodeAddress(const web3::type::address& address);
 type::bytes encodeBool(bool val);
 type::bytes encodeBytes(type::bytes bytes);
 }  // namespace web3::utils
+
+namespace web3::literals
+{
+
+namespace detail
+{
+
+template <char... C>
+struct Chars
+{
+    static constexpr char text[] = {C...};
+};
+
+// A variable template forces the literal to be evaluated, and diagnosed,
+// at compile time.
+template <utils::Unit U, char... C>
+constexpr type::uint256 literal = utils::parseAmount(
+    std::string_view(Chars<C...>::text, sizeof...(C)), U);
+
+}  // namespace detail
+
+template <char... C>
+constexpr type::uint256 operator""_u256()
+{
+    return detail::literal<utils::Unit::WEI, C...>;
+}
+
+template <char... C>
+constexpr type::uint256 operator""_wei()
+{
+    return detail::literal<utils::Unit::WEI, C...>;
+}
+
+template <char... C>
+constexpr type::uint256 operator""_gwei()
+{
+    return detail::literal<utils::Unit::GWEI, C...>;
+}
+
+template <char... C>
+constexpr type::uint256 operator""_ether()
+{
+    return detail::literal<utils::Unit::ETHER, C...>;
+}
+
+}  // namespace web3::literals
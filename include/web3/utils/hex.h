@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace web3::utils::hex
+{
+
+/**
+ * Hex encode, decode and validate kernels.
+ *
+ * Each call dispatches to the widest implementation the CPU supports (AVX2,
+ * SSSE3 or scalar), chosen once at startup. All functions write into caller
+ * provided buffers and never allocate. Encoding is lowercase and none of the
+ * functions deal with a "0x" prefix; use stripPrefix() first.
+ */
+
+// Writes 2 * size characters to out.
+void encode(const uint8_t* data, size_t size, char* out);
+
+// Decodes size characters into size / 2 bytes. Returns false if size is odd
+// or any character is not a hex digit; out is then unspecified.
+bool decode(const char* text, size_t size, uint8_t* out);
+
+// True if every character is a hex digit. Empty text is valid.
+bool validate(const char* text, size_t size);
+
+// Name of the implementation in use, "avx2", "ssse3" or "scalar".
+const char* implementation();
+
+inline bool hasPrefix(std::string_view text)
+{
+    return text.size() >= 2 && text[0] == '0' &&
+           (text[1] == 'x' || text[1] == 'X');
+}
+
+inline std::string_view stripPrefix(std::string_view text)
+{
+    return hasPrefix(text) ? text.substr(2) : text;
+}
+
+}  // namespace web3::utils::hex
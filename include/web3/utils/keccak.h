@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "types/native.h"
+
+namespace web3::utils
+{
+
+using Hash256 = std::array<uint8_t, 32>;
+
+/**
+ * @brief Incremental Keccak-256 (the original padding Ethereum uses, not
+ * SHA3-256). Keeps all state inline and never allocates.
+ */
+class Keccak256
+{
+   public:
+    Keccak256()
+    {
+        reset();
+    }
+
+    void reset();
+
+    Keccak256& update(const uint8_t* data, size_t size);
+
+    Keccak256& update(std::string_view data)
+    {
+        return update(reinterpret_cast<const uint8_t*>(data.data()),
+                      data.size());
+    }
+
+    // Writes the digest and resets the hasher for reuse.
+    void finalize(uint8_t* out);
+
+    Hash256 finalize()
+    {
+        Hash256 out;
+        finalize(out.data());
+        return out;
+    }
+
+    static Hash256 hash(const uint8_t* data, size_t size)
+    {
+        return Keccak256().update(data, size).finalize();
+    }
+
+    static Hash256 hash(std::string_view data)
+    {
+        return Keccak256().update(data).finalize();
+    }
+
+   private:
+    uint64_t state_[25];
+    uint8_t buffer_[136];
+    size_t buffered_;
+};
+
+// Hashes count independent inputs, data[i] of sizes[i] bytes, into out[i].
+// Inputs of equal block count are hashed several at a time in SIMD lanes
+// (AVX-512 8-way or AVX2 4-way, chosen at runtime), so this is much faster
+// than hashing them one by one when there are many small inputs.
+void keccak256Batch(const uint8_t* const* data, const size_t* sizes,
+                    size_t count, Hash256* out);
+
+std::vector<Hash256> keccak256Batch(const std::vector<type::bytes>& inputs);
+
+}  // namespace web3::utils
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types/native.h"
+#include "types/request.h"
+#include "types/response.h"
+
+namespace web3::utils::rlp
+{
+
+/**
+ * @brief Two-pass RLP serializer.
+ *
+ * An encoder is a callable taking a Writer& that emits items in order. It is
+ * run twice: the first pass only adds up sizes and records the payload length
+ * of every list, the second writes straight into one buffer of exactly that
+ * size. The encoder must emit the same items both times.
+ *
+ *   auto out = rlp::encode([&](rlp::Writer& w)
+ *                          {
+ *                              w.list([&](rlp::Writer& w)
+ *                                     {
+ *                                         w.uint(nonce);
+ *                                         w.address(to);
+ *                                     });
+ *                          });
+ */
+class Writer
+{
+   public:
+    void bytes(const uint8_t* data, size_t size);
+
+    void bytes(const type::bytes& data)
+    {
+        bytes(data.data(), data.size());
+    }
+
+    // A hex string, with or without 0x, written as the bytes it encodes.
+    void hex(std::string_view text);
+
+    // Integers are big-endian with no leading zeros; zero is empty.
+    void uint(const type::uint256& value);
+
+    void address(const type::address& value)
+    {
+        bytes(value.bytes.data(), value.bytes.size());
+    }
+
+    // Copies an already encoded item verbatim.
+    void raw(const uint8_t* data, size_t size);
+
+    template <typename F>
+    void list(F&& items)
+    {
+        if (out_)
+        {
+            header(0xc0, lists_[cursor_++]);
+            items(*this);
+            return;
+        }
+
+        size_t index = lists_.size();
+        lists_.push_back(0);
+        size_t start = size_;
+        items(*this);
+        lists_[index] = size_ - start;
+        size_ += headerSize(size_ - start);
+    }
+
+    // Bytes emitted so far; the total once the measuring pass is done.
+    size_t size() const
+    {
+        return size_;
+    }
+
+    template <typename F>
+    friend size_t encode(F&& encoder, uint8_t* out, size_t capacity);
+
+    template <typename F>
+    friend type::bytes encode(F&& encoder);
+
+   private:
+    static size_t headerSize(size_t payload)
+    {
+        size_t size = 1;
+        if (payload > 55)
+            for (; payload; payload >>= 8)
+                size++;
+        return size;
+    }
+
+    void header(uint8_t base, size_t payload);
+
+    void begin(uint8_t* out)
+    {
+        out_ = out;
+        cursor_ = 0;
+    }
+
+    std::vector<size_t> lists_;
+    size_t cursor_ = 0;
+    size_t size_ = 0;
+    uint8_t* out_ = nullptr;
+};
+
+// Encodes into a caller supplied buffer, returning the number of bytes
+// written. Throws std::length_error if capacity is too small.
+template <typename F>
+size_t encode(F&& encoder, uint8_t* out, size_t capacity)
+{
+    Writer w;
+    encoder(w);
+    if (w.size_ > capacity)
+        throw std::length_error("RLP output buffer too small");
+    w.begin(out);
+    encoder(w);
+    return w.size_;
+}
+
+template <typename F>
+type::bytes encode(F&& encoder)
+{
+    Writer w;
+    encoder(w);
+    type::bytes out(w.size_);
+    w.begin(out.data());
+    encoder(w);
+    return out;
+}
+
+type::bytes encodeBytes(const type::bytes& bytes);
+type::bytes encodeUint256(const type::uint256& value);
+type::bytes encodeAddress(const type::address& addr);
+// Wraps already encoded items in a list.
+type::bytes encodeList(const std::vector<type::bytes>& items);
+type::bytes encodeAccessList(
+    const std::vector<type::response::AccessList>& accessList);
+type::bytes encodeAuthorizationList(
+    const std::vector<type::response::AuthorizationList>& authList);
+
+void writeAccessList(Writer& w,
+                     const std::vector<type::response::AccessList>& list);
+void writeAuthorizationList(
+    Writer& w, const std::vector<type::response::AuthorizationList>& list);
+
+// Signing payloads, whose keccak256 is the hash to sign. A zero `to`
+// address encodes as empty, i.e. contract creation.
+type::bytes encodeLegacyTransaction(const type::request::Transaction& tx);
+type::bytes encodeEIP2930Transaction(const type::request::Transaction& tx);
+type::bytes encodeEIP1559Transaction(const type::request::Transaction& tx);
+type::bytes encodeEIP4844Transaction(const type::request::Transaction& tx);
+type::bytes encodeEIP7702Transaction(const type::request::Transaction& tx);
+
+// Signing payload for tx.type.
+type::bytes encodeTransaction(const type::request::Transaction& tx);
+
+// Network encoding of tx signed with the given signature; r and s are hex.
+type::bytes encodeSignedTransaction(const type::request::Transaction& tx,
+                                    uint8_t yParity, std::string_view r,
+                                    std::string_view s);
+
+/**
+ * @brief Non-owning view of one RLP item.
+ *
+ * Views point into the buffer they were parsed from, which must outlive
+ * them. Lists are not expanded up front; iterating one parses each child as
+ * it is reached. Malformed or non-canonical input throws.
+ */
+class Item
+{
+   public:
+    class Iterator
+    {
+       public:
+        Iterator(const uint8_t* pos, const uint8_t* end) : pos_(pos), end_(end)
+        {
+        }
+
+        Item operator*() const
+        {
+            return Item::parse(pos_, end_ - pos_, true);
+        }
+
+        Iterator& operator++()
+        {
+            pos_ += (**this).encodedSize();
+            return *this;
+        }
+
+        bool operator==(const Iterator& o) const
+        {
+            return pos_ == o.pos_;
+        }
+        bool operator!=(const Iterator& o) const
+        {
+            return pos_ != o.pos_;
+        }
+
+       private:
+        const uint8_t* pos_;
+        const uint8_t* end_;
+    };
+
+    Item() = default;
+
+    // Parses the item at data. Unless trailing is true the item must span
+    // the whole buffer.
+    static Item parse(const uint8_t* data, size_t size, bool trailing = false);
+
+    static Item parse(const type::bytes& data)
+    {
+        return parse(data.data(), data.size());
+    }
+
+    bool isList() const
+    {
+        return list_;
+    }
+
+    // Payload, without the header.
+    const uint8_t* data() const
+    {
+        return payload_;
+    }
+    size_t size() const
+    {
+        return size_;
+    }
+
+    // Header and payload, i.e. the bytes this item was parsed from.
+    const uint8_t* encoded() const
+    {
+        return payload_ - header_;
+    }
+    size_t encodedSize() const
+    {
+        return header_ + size_;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(payload_, list_ ? payload_ + size_ : payload_);
+    }
+    Iterator end() const
+    {
+        const uint8_t* stop = list_ ? payload_ + size_ : payload_;
+        return Iterator(stop, stop);
+    }
+
+    // Number of list elements; walks the list.
+    size_t count() const;
+    // The i-th list element; walks the list.
+    Item operator[](size_t index) const;
+
+    // String accessors, which throw for lists.
+    type::bytes bytes() const;
+    std::string toHex() const;
+    type::uint256 toUint256() const;
+    uint64_t toU64() const;
+    type::address toAddress() const;
+
+   private:
+    void expectString() const;
+
+    const uint8_t* payload_ = nullptr;
+    size_t size_ = 0;
+    size_t header_ = 0;
+    bool list_ = false;
+};
+
+/**
+ * @brief A decoded transaction and its signature, if it carried one.
+ *
+ * `from` is not part of the encoding and is left zero.
+ */
+struct DecodedTransaction
+{
+    type::request::Transaction tx;
+    bool isSigned = false;
+    uint8_t yParity = 0;
+    type::uint256 r;
+    type::uint256 s;
+};
+
+// Decoders for the field list of each transaction type. Both the signing
+// payload and the signed form are accepted.
+DecodedTransaction decodeLegacyTransaction(const Item& fields);
+DecodedTransaction decodeEIP2930Transaction(const Item& fields);
+DecodedTransaction decodeEIP1559Transaction(const Item& fields);
+DecodedTransaction decodeEIP4844Transaction(const Item& fields);
+DecodedTransaction decodeEIP7702Transaction(const Item& fields);
+
+// Decodes a raw transaction, legacy or EIP-2718 typed.
+DecodedTransaction decodeTransaction(const uint8_t* data, size_t size);
+
+inline DecodedTransaction decodeTransaction(const type::bytes& data)
+{
+    return decodeTransaction(data.data(), data.size());
+}
+
+// Decodes a transaction as it appears inside a block body, where typed
+// transactions are wrapped in a byte string.
+DecodedTransaction decodeTransaction(const Item& item);
+
+}  // namespace web3::utils::rlp
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace web3::utils
+{
+
+/**
+ * @brief Fixed set of worker threads running queued tasks in FIFO order.
+ *
+ * shared() returns a process-wide pool sized to the hardware concurrency,
+ * which is what the library's parallel helpers use unless handed another.
+ */
+class ThreadPool
+{
+   public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+    // Finishes the queued tasks, then joins the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const
+    {
+        return workers_.size();
+    }
+
+    void post(std::function<void()> task);
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& f)
+    {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(f));
+        auto future = task->get_future();
+        post([task] { (*task)(); });
+        return future;
+    }
+
+    // Calls f(begin, end) over contiguous ranges covering [0, count) and
+    // blocks until all of them ran. The calling thread takes ranges too, so
+    // this is safe to call from inside a pool task. Rethrows the first
+    // exception thrown by f.
+    void parallelFor(size_t count,
+                     const std::function<void(size_t, size_t)>& f,
+                     size_t grain = 1);
+
+    static ThreadPool& shared();
+
+   private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace web3::utils
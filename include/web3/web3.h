@@ -1,6 +1,7 @@
 #pragma once
 
 #include "anvil/index.h"
+#include "core/connector.h"
 #include "eth/index.h"
 
 namespace web3
@@ -3,7 +3,7 @@
 namespace web3::anvil
 {
 
-Anvil::Anvil(RPC& rpc) : rpc_{rpc}, accounts_{}
+Anvil::Anvil(RPC& rpc) : rpc_{rpc}, accounts_{rpc}
 {
 }
 
@@ -0,0 +1,308 @@
+#include "core/async.h"
+
+#include <curl/curl.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "core/error.h"
+
+namespace web3::rpc
+{
+
+namespace
+{
+
+std::exception_ptr cancelledError()
+{
+    return std::make_exception_ptr(
+        JsonRPCException(Error::INTERNAL, "Request cancelled."));
+}
+
+void deliver(const ResponseHandler& handler, std::string response,
+             std::exception_ptr error)
+{
+    // A throwing handler must not take the event loop down with it.
+    try
+    {
+        handler(std::move(response), error);
+    }
+    catch (...)
+    {
+    }
+}
+
+}  // namespace
+
+AsyncHTTPClient::AsyncHTTPClient(const std::string& host, int port,
+                                 const AsyncOptions& options)
+    : url_{"http://" + host + ":" + std::to_string(port) + "/jsonrpc"},
+      headers_{nullptr},
+      options_{options},
+      multi_{nullptr},
+      active_{0},
+      nextId_{1},
+      stop_{false}
+{
+    if (options_.maxInFlight == 0)
+        throw std::invalid_argument(
+            "In-flight limit must be greater than zero.");
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    multi_ = curl_multi_init();
+    if (!multi_)
+        throw std::runtime_error("Failed to init CURL multi handle.");
+
+    headers_ = curl_slist_append(headers_, "Content-Type: application/json");
+    curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(options_.maxInFlight));
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    loop_ = std::thread(&AsyncHTTPClient::run, this);
+}
+
+AsyncHTTPClient::~AsyncHTTPClient()
+{
+    stop_ = true;
+    curl_multi_wakeup(multi_);
+    loop_.join();
+
+    for (CURL* curl : handles_)
+        curl_easy_cleanup(curl);
+    curl_multi_cleanup(multi_);
+    curl_slist_free_all(headers_);
+    curl_global_cleanup();
+}
+
+std::string AsyncHTTPClient::send(const std::string& request)
+{
+    return sendAsync(request).get();
+}
+
+uint64_t AsyncHTTPClient::sendAsync(const std::string& request,
+                                    ResponseHandler handler)
+{
+    auto transfer = std::make_unique<Transfer>();
+    transfer->id = nextId_++;
+    transfer->request = request;
+    transfer->handler = std::move(handler);
+
+    uint64_t id = transfer->id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.insert(id);
+        queue_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_);
+    return id;
+}
+
+bool AsyncHTTPClient::cancel(uint64_t requestId)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.erase(requestId) == 0)
+            return false;
+        cancelled_.push_back(requestId);
+    }
+    curl_multi_wakeup(multi_);
+    return true;
+}
+
+size_t AsyncHTTPClient::inFlight() const
+{
+    return active_;
+}
+
+size_t AsyncHTTPClient::queued() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void AsyncHTTPClient::run()
+{
+    while (true)
+    {
+        std::vector<std::unique_ptr<Transfer>> dropped;
+        std::vector<std::pair<std::unique_ptr<Transfer>, std::exception_ptr>>
+            failed;
+        bool stopping = stop_;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (uint64_t id : cancelled_)
+            {
+                auto running = running_.find(id);
+                if (running != running_.end())
+                {
+                    curl_multi_remove_handle(multi_, running->second->curl);
+                    releaseHandle(running->second->curl);
+                    dropped.push_back(std::move(running->second));
+                    running_.erase(running);
+                    continue;
+                }
+                for (auto it = queue_.begin(); it != queue_.end(); ++it)
+                {
+                    if ((*it)->id != id)
+                        continue;
+                    dropped.push_back(std::move(*it));
+                    queue_.erase(it);
+                    break;
+                }
+            }
+            cancelled_.clear();
+
+            if (stopping)
+            {
+                for (auto& [id, transfer] : running_)
+                {
+                    curl_multi_remove_handle(multi_, transfer->curl);
+                    releaseHandle(transfer->curl);
+                    dropped.push_back(std::move(transfer));
+                }
+                running_.clear();
+                for (auto& transfer : queue_)
+                    dropped.push_back(std::move(transfer));
+                queue_.clear();
+                pending_.clear();
+            }
+
+            while (!queue_.empty() && running_.size() < options_.maxInFlight)
+            {
+                std::unique_ptr<Transfer> transfer = std::move(queue_.front());
+                queue_.pop_front();
+                if (auto error = start(transfer))
+                {
+                    pending_.erase(transfer->id);
+                    failed.emplace_back(std::move(transfer), error);
+                }
+            }
+            active_ = running_.size();
+        }
+
+        for (auto& transfer : dropped)
+            deliver(transfer->handler, {}, cancelledError());
+        for (auto& [transfer, error] : failed)
+            deliver(transfer->handler, {}, error);
+
+        if (stopping)
+            break;
+
+        int running = 0;
+        curl_multi_perform(multi_, &running);
+
+        CURLMsg* msg;
+        int left = 0;
+        while ((msg = curl_multi_info_read(multi_, &left)))
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+
+            Transfer* done = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &done);
+            CURLcode result = msg->data.result;
+
+            auto it = running_.find(done->id);
+            std::unique_ptr<Transfer> transfer = std::move(it->second);
+            running_.erase(it);
+
+            auto error = finish(*transfer, result);
+            deliver(transfer->handler, std::move(transfer->response), error);
+        }
+
+        curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+    }
+}
+
+std::exception_ptr AsyncHTTPClient::start(std::unique_ptr<Transfer>& transfer)
+{
+    CURL* curl = acquireHandle();
+    if (!curl)
+        return std::make_exception_ptr(
+            JsonRPCException(-32003, "Connection Error: failed to init CURL."));
+    transfer->curl = curl;
+
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, transfer->request.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, transfer->request.size());
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer->response);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, transfer.get());
+
+    curl_multi_add_handle(multi_, curl);
+    running_.emplace(transfer->id, std::move(transfer));
+    return nullptr;
+}
+
+std::exception_ptr AsyncHTTPClient::finish(Transfer& transfer, CURLcode result)
+{
+    long code = 0;
+    curl_easy_getinfo(transfer.curl, CURLINFO_RESPONSE_CODE, &code);
+    curl_multi_remove_handle(multi_, transfer.curl);
+
+    bool claimed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        releaseHandle(transfer.curl);
+        claimed = pending_.erase(transfer.id) > 0;
+        active_ = running_.size();
+    }
+
+    if (!claimed)
+        return cancelledError();
+
+    if (result != CURLE_OK)
+        return std::make_exception_ptr(
+            JsonRPCException(-32003, std::string("Connection Error: ") +
+                                         curl_easy_strerror(result)));
+
+    if (code != 200)
+        return std::make_exception_ptr(JsonRPCException(
+            -32003,
+            std::string("Client Connection Error - Received Non-200 Status")));
+
+    return nullptr;
+}
+
+CURL* AsyncHTTPClient::acquireHandle()
+{
+    if (!handles_.empty())
+    {
+        CURL* curl = handles_.back();
+        handles_.pop_back();
+        return curl;
+    }
+
+    CURL* curl = curl_easy_init();
+    if (!curl)
+        return nullptr;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers_);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    if (options_.requestTimeout.count() > 0)
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS,
+                         static_cast<long>(options_.requestTimeout.count()));
+    return curl;
+}
+
+void AsyncHTTPClient::releaseHandle(CURL* curl)
+{
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, nullptr);
+    handles_.push_back(curl);
+}
+
+size_t AsyncHTTPClient::writeCallback(void* contents, size_t size,
+                                      size_t nmemb, void* userp)
+{
+    size_t total = size * nmemb;
+    std::string* out = reinterpret_cast<std::string*>(userp);
+    out->append(static_cast<char*>(contents), total);
+    return total;
+}
+
+}  // namespace web3::rpc
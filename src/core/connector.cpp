@@ -11,36 +11,44 @@ namespace web3::rpc
 {
 
 HTTPClient::HTTPClient(const std::string& host, int port)
-    : host_{host}, port_{port}
+    : host_{host},
+      port_{port},
+      url_{"http://" + host + ":" + std::to_string(port) + "/jsonrpc"},
+      headers_{nullptr}
 {
     curl_global_init(CURL_GLOBAL_DEFAULT);
+    headers_ = curl_slist_append(headers_, "Content-Type: application/json");
 }
 
 HTTPClient::~HTTPClient()
 {
+    curl_slist_free_all(headers_);
     curl_global_cleanup();
 }
 
 std::string HTTPClient::send(const std::string& request)
+{
+    std::string response;
+    sendInto(request, response);
+    return response;
+}
+
+void HTTPClient::sendInto(const std::string& request, std::string& response)
 {
     CURL* curl = curl_easy_init();
     if (!curl)
         throw std::runtime_error("Failed to init CURL.");
 
-    std::string response;
-    std::string url =
-        "http://" + host_ + ":" + std::to_string(port_) + "/jsonrpc";
+    response.clear();
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
 
     curl_easy_setopt(curl, CURLOPT_POST, 1L);
 
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.size());
 
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers_);
 
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
@@ -50,7 +58,6 @@ std::string HTTPClient::send(const std::string& request)
     long code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
 
-    curl_slist_free_all(headers);
     curl_easy_cleanup(curl);
 
     if (res != CURLE_OK)
@@ -61,8 +68,6 @@ std::string HTTPClient::send(const std::string& request)
         throw JsonRPCException(
             -32003,
             std::string("Client Connection Error - Received Non-200 Status"));
-
-    return response;
 }
 
 size_t HTTPClient::writeCallback(void* contents, size_t size, size_t nmemb,
@@ -0,0 +1,123 @@
+#include "core/ipc.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "core/error.h"
+#include "core/json_scan.h"
+
+namespace web3::rpc
+{
+
+namespace
+{
+
+JsonRPCException connectionError(const std::string& what)
+{
+    return JsonRPCException(-32003, "Connection Error: " + what);
+}
+
+int connectUnix(const std::string& path)
+{
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path))
+        throw connectionError("IPC path too long: " + path);
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw connectionError(std::strerror(errno));
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        int err = errno;
+        close(fd);
+        throw connectionError("could not connect to " + path + ": " +
+                              std::strerror(err));
+    }
+
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return fd;
+}
+
+}  // namespace
+
+IPCClient::IPCClient(const std::string& path)
+    : fd_{connectUnix(path)}, closing_{false}
+{
+    reader_ = std::thread(&IPCClient::run, this);
+}
+
+IPCClient::~IPCClient()
+{
+    closing_ = true;
+    shutdown(fd_, SHUT_RDWR);
+    reader_.join();
+    close(fd_);
+}
+
+void IPCClient::write(const std::string& message)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sendAll(fd_, message.data(), message.size());
+    sendAll(fd_, "\n", 1);
+}
+
+void IPCClient::run()
+{
+    std::string buffer;
+    scan::Splitter splitter;
+    size_t consumed = 0;
+    std::exception_ptr error;
+
+    try
+    {
+        while (true)
+        {
+            size_t end;
+            while ((end = splitter.next(buffer)) != scan::npos)
+            {
+                size_t begin = splitter.begin();
+                onMessage(std::string_view(buffer).substr(begin, end - begin));
+                consumed = end;
+            }
+
+            // Drop handled messages before reading more, keeping a partial
+            // one at the front of the buffer.
+            if (consumed > 0)
+            {
+                buffer.erase(0, consumed);
+                splitter.discard(consumed);
+                consumed = 0;
+            }
+
+            char chunk[65536];
+            ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                throw connectionError(n == 0 ? "IPC connection closed"
+                                             : std::strerror(errno));
+            buffer.append(chunk, n);
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    if (closing_)
+        error =
+            std::make_exception_ptr(connectionError("IPC connector shut down"));
+    onClose(error);
+}
+
+}  // namespace web3::rpc
@@ -0,0 +1,214 @@
+#include "core/pool.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "core/error.h"
+
+namespace web3::rpc
+{
+
+class PooledHTTPClient::Lease
+{
+   public:
+    explicit Lease(PooledHTTPClient& pool) : pool_(pool), curl_(pool.checkout())
+    {
+    }
+    ~Lease()
+    {
+        pool_.checkin(curl_);
+    }
+
+    CURL* get() const
+    {
+        return curl_;
+    }
+
+   private:
+    PooledHTTPClient& pool_;
+    CURL* curl_;
+};
+
+PooledHTTPClient::PooledHTTPClient(const std::string& host, int port,
+                                   const PoolOptions& options)
+    : url_{"http://" + host + ":" + std::to_string(port) + "/jsonrpc"},
+      headers_{nullptr},
+      options_{options},
+      open_{0}
+{
+    if (options_.maxHandles == 0)
+        throw std::invalid_argument("Pool size must be greater than zero.");
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    headers_ = curl_slist_append(headers_, "Content-Type: application/json");
+    idle_.reserve(options_.maxHandles);
+}
+
+PooledHTTPClient::~PooledHTTPClient()
+{
+    for (auto& handle : idle_)
+        curl_easy_cleanup(handle.curl);
+    curl_slist_free_all(headers_);
+    curl_global_cleanup();
+}
+
+std::string PooledHTTPClient::send(const std::string& request)
+{
+    std::string response;
+    sendInto(request, response);
+    return response;
+}
+
+void PooledHTTPClient::sendInto(const std::string& request,
+                                std::string& response)
+{
+    Lease lease(*this);
+    CURL* curl = lease.get();
+
+    response.clear();
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.size());
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+
+    CURLcode res = curl_easy_perform(curl);
+
+    long code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+
+    if (res != CURLE_OK)
+        throw JsonRPCException(-32003, std::string("Connection Error: ") +
+                                           curl_easy_strerror(res));
+
+    if (code != 200)
+        throw JsonRPCException(
+            -32003,
+            std::string("Client Connection Error - Received Non-200 Status"));
+}
+
+size_t PooledHTTPClient::openHandles() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+size_t PooledHTTPClient::idleHandles() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+CURL* PooledHTTPClient::checkout()
+{
+    std::vector<CURL*> expired;
+    CURL* curl = nullptr;
+    bool create = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        evictExpired(expired);
+        available_.wait(lock, [this]
+                        { return !idle_.empty() || open_ < options_.maxHandles; });
+
+        if (!idle_.empty())
+        {
+            // Prefer the handle this thread used last, otherwise the most
+            // recently returned one, whose connection is the least likely to
+            // have been dropped by the server.
+            auto self = std::this_thread::get_id();
+            auto it = std::find_if(idle_.rbegin(), idle_.rend(),
+                                   [&](const Handle& h)
+                                   { return h.lastOwner == self; });
+            auto pos = it != idle_.rend() ? std::prev(it.base())
+                                          : std::prev(idle_.end());
+            curl = pos->curl;
+            idle_.erase(pos);
+        }
+        else
+        {
+            ++open_;
+            create = true;
+        }
+    }
+
+    for (CURL* handle : expired)
+        curl_easy_cleanup(handle);
+
+    if (create)
+    {
+        curl = createHandle();
+        if (!curl)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --open_;
+            available_.notify_one();
+            throw std::runtime_error("Failed to init CURL.");
+        }
+    }
+    return curl;
+}
+
+void PooledHTTPClient::checkin(CURL* curl)
+{
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(
+            {curl, std::this_thread::get_id(), std::chrono::steady_clock::now()});
+    }
+    available_.notify_one();
+}
+
+CURL* PooledHTTPClient::createHandle()
+{
+    CURL* curl = curl_easy_init();
+    if (!curl)
+        return nullptr;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers_);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    auto idle = std::chrono::duration_cast<std::chrono::seconds>(
+        options_.idleTimeout);
+    curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN,
+                     static_cast<long>(std::max<long long>(1, idle.count())));
+
+    if (options_.requestTimeout.count() > 0)
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS,
+                         static_cast<long>(options_.requestTimeout.count()));
+
+    return curl;
+}
+
+void PooledHTTPClient::evictExpired(std::vector<CURL*>& expired)
+{
+    auto deadline = std::chrono::steady_clock::now() - options_.idleTimeout;
+    auto it = std::remove_if(idle_.begin(), idle_.end(),
+                             [&](const Handle& h)
+                             {
+                                 if (h.lastUsed >= deadline)
+                                     return false;
+                                 expired.push_back(h.curl);
+                                 return true;
+                             });
+    open_ -= std::distance(it, idle_.end());
+    idle_.erase(it, idle_.end());
+}
+
+size_t PooledHTTPClient::writeCallback(void* contents, size_t size,
+                                       size_t nmemb, void* userp)
+{
+    size_t total = size * nmemb;
+    std::string* out = reinterpret_cast<std::string*>(userp);
+    out->append(static_cast<char*>(contents), total);
+    return total;
+}
+
+}  // namespace web3::rpc
@@ -0,0 +1,464 @@
+#include "core/stream.h"
+
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <string>
+
+#include "core/error.h"
+#include "core/json_scan.h"
+
+namespace web3::rpc
+{
+
+namespace
+{
+
+void deliver(const ResponseHandler& handler, std::string response,
+             std::exception_ptr error)
+{
+    // A throwing handler must not take the reader thread down with it.
+    try
+    {
+        handler(std::move(response), error);
+    }
+    catch (...)
+    {
+    }
+}
+
+uint64_t parseWireId(std::string_view text)
+{
+    uint64_t id = 0;
+    for (char c : text)
+    {
+        if (c < '0' || c > '9')
+            return 0;
+        id = id * 10 + (c - '0');
+    }
+    return id;
+}
+
+// Offsets of the top-level "id" value of the object, or of every element
+// when the message is a batch.
+std::vector<std::pair<size_t, size_t>> idSpans(std::string_view message)
+{
+    std::vector<std::pair<size_t, size_t>> spans;
+    auto collect = [&](size_t pos)
+    {
+        scan::forEachMember(message, pos,
+                            [&](std::string_view key, size_t begin, size_t end)
+                            {
+                                if (key != "id")
+                                    return true;
+                                spans.emplace_back(begin, end);
+                                return false;
+                            });
+    };
+
+    size_t pos = scan::skipSpace(message, 0);
+    if (pos < message.size() && message[pos] == '[')
+        scan::forEachElement(message, pos,
+                             [&](size_t begin, size_t)
+                             {
+                                 collect(begin);
+                                 return true;
+                             });
+    else
+        collect(pos);
+    return spans;
+}
+
+// Waits for the reply to requestId. Past the timeout the request is
+// cancelled, unless its reply won the race.
+template <typename T>
+T await(StreamConnector& connector, uint64_t requestId,
+        std::future<T>& future, std::chrono::milliseconds timeout)
+{
+    if (timeout > std::chrono::milliseconds::zero() &&
+        future.wait_for(timeout) == std::future_status::timeout &&
+        connector.cancel(requestId))
+        throw JsonRPCException(-32003, "Connection Error: request timed out");
+    return future.get();
+}
+
+}  // namespace
+
+std::string StreamConnector::send(const std::string& request)
+{
+    auto promise = std::make_shared<std::promise<std::string>>();
+    auto future = promise->get_future();
+    uint64_t requestId = sendAsync(
+        request,
+        [promise](std::string response, std::exception_ptr error)
+        {
+            if (error)
+                promise->set_exception(error);
+            else
+                promise->set_value(std::move(response));
+        });
+    return await(*this, requestId, future, timeout_);
+}
+
+uint64_t StreamConnector::sendAsync(const std::string& request,
+                                    ResponseHandler handler)
+{
+    uint64_t requestId = nextId_++;
+
+    Pending pending;
+    std::string message = rewriteIds(request, pending);
+    if (pending.ids.empty())
+    {
+        // A notification, the node will not answer it.
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_)
+                error = closeError_;
+        }
+        if (!error)
+        {
+            try
+            {
+                write(message);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+        deliver(handler, {}, error);
+        return requestId;
+    }
+
+    std::exception_ptr closed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_)
+        {
+            closed = closeError_;
+        }
+        else
+        {
+            for (const auto& id : pending.ids)
+                wire_[id.first] = requestId;
+            pending.handler = std::move(handler);
+            pending_.emplace(requestId, std::move(pending));
+        }
+    }
+    if (closed)
+    {
+        deliver(handler, {}, closed);
+        return requestId;
+    }
+
+    try
+    {
+        write(message);
+    }
+    catch (...)
+    {
+        auto error = std::current_exception();
+        ResponseHandler failed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(requestId);
+            if (it == pending_.end())
+                return requestId;
+            for (const auto& id : it->second.ids)
+                wire_.erase(id.first);
+            failed = std::move(it->second.handler);
+            pending_.erase(it);
+        }
+        deliver(failed, {}, error);
+    }
+    return requestId;
+}
+
+bool StreamConnector::cancel(uint64_t requestId)
+{
+    ResponseHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(requestId);
+        if (it == pending_.end())
+            return false;
+        for (const auto& id : it->second.ids)
+            wire_.erase(id.first);
+        handler = std::move(it->second.handler);
+        pending_.erase(it);
+    }
+    deliver(handler, {},
+            std::make_exception_ptr(
+                JsonRPCException(Error::INTERNAL, "Request cancelled.")));
+    return true;
+}
+
+std::string StreamConnector::subscribe(const std::string& params,
+                                       NotificationHandler handler)
+{
+    auto promise = std::make_shared<std::promise<std::string>>();
+    auto future = promise->get_future();
+    auto shared = std::make_shared<NotificationHandler>(std::move(handler));
+
+    std::string request =
+        R"({"jsonrpc":"2.0","id":0,"method":"eth_subscribe","params":)" +
+        params + "}";
+
+    // Registration happens on the reader thread before it looks at the next
+    // message, so no notification can slip past the handler.
+    uint64_t requestId = sendAsync(
+        request,
+        [this, promise, shared](std::string response, std::exception_ptr error)
+        {
+            try
+            {
+                if (error)
+                    std::rethrow_exception(error);
+
+                auto j = nlohmann::json::parse(response);
+                if (hasTypedKey(j, "error", nlohmann::json::value_t::object))
+                    throw JsonRPCException::from_json(j["error"]);
+                if (!hasTypedKey(j, "result", nlohmann::json::value_t::string))
+                    throw JsonRPCException(Error::INTERNAL,
+                                           "Invalid eth_subscribe response.");
+
+                auto id = j["result"].get<std::string>();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    subscriptions_[id] = shared;
+                }
+                promise->set_value(id);
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        });
+
+    return await(*this, requestId, future, timeout_);
+}
+
+bool StreamConnector::unsubscribe(const std::string& subscriptionId)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriptions_.erase(subscriptionId) == 0)
+            return false;
+        if (closed_)
+            return true;
+    }
+
+    nlohmann::json request = {{"jsonrpc", "2.0"},
+                              {"id", 0},
+                              {"method", "eth_unsubscribe"},
+                              {"params", {subscriptionId}}};
+    auto response = nlohmann::json::parse(send(request.dump()));
+    if (hasTypedKey(response, "error", nlohmann::json::value_t::object))
+        throw JsonRPCException::from_json(response["error"]);
+    return true;
+}
+
+void StreamConnector::onMessage(std::string_view message)
+{
+    size_t pos = scan::skipSpace(message, 0);
+    if (pos >= message.size())
+        return;
+
+    if (message[pos] == '[')
+    {
+        onResponse(message, {});
+        return;
+    }
+
+    std::string_view id, method, params, error;
+    scan::forEachMember(message, pos,
+                        [&](std::string_view key, size_t begin, size_t end)
+                        {
+                            auto value = message.substr(begin, end - begin);
+                            if (key == "id")
+                                id = value;
+                            else if (key == "method")
+                                method = value;
+                            else if (key == "params")
+                                params = value;
+                            else if (key == "error")
+                                error = value;
+                            return true;
+                        });
+
+    if (method == R"("eth_subscription")")
+        onNotification(params);
+    else if (!id.empty())
+        onResponse(message, error);
+}
+
+void StreamConnector::setTimeout(std::chrono::milliseconds timeout)
+{
+    timeout_ = timeout;
+}
+
+void StreamConnector::sendAll(int fd, const char* data, size_t size)
+{
+#ifdef MSG_NOSIGNAL
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif
+    while (size > 0)
+    {
+        ssize_t n = ::send(fd, data, size, flags);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            throw JsonRPCException(
+                -32003, std::string("Connection Error: ") + std::strerror(errno));
+        data += n;
+        size -= n;
+    }
+}
+
+void StreamConnector::onClose(std::exception_ptr error)
+{
+    std::unordered_map<uint64_t, Pending> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        closeError_ = error;
+        pending.swap(pending_);
+        wire_.clear();
+        subscriptions_.clear();
+    }
+    for (auto& entry : pending)
+        deliver(entry.second.handler, {}, error);
+}
+
+std::string StreamConnector::rewriteIds(const std::string& request,
+                                        Pending& pending)
+{
+    auto spans = idSpans(request);
+
+    std::string message;
+    message.reserve(request.size() + spans.size() * 8);
+    size_t last = 0;
+    for (const auto& [begin, end] : spans)
+    {
+        uint64_t wire = nextId_++;
+        pending.ids.emplace_back(wire,
+                                 request.substr(begin, end - begin));
+        message.append(request, last, begin - last);
+        message += std::to_string(wire);
+        last = end;
+    }
+    message.append(request, last, std::string::npos);
+    return message;
+}
+
+void StreamConnector::onResponse(std::string_view message,
+                                 std::string_view error)
+{
+    auto spans = idSpans(message);
+
+    Pending pending;
+    bool orphan = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Any one known id identifies the request; a batch reply may list
+        // them in any order.
+        auto it = pending_.end();
+        for (const auto& [begin, end] : spans)
+        {
+            auto wire =
+                wire_.find(parseWireId(message.substr(begin, end - begin)));
+            if (wire == wire_.end())
+                continue;
+            it = pending_.find(wire->second);
+            break;
+        }
+        // The node answers with id null when it could not read the request
+        // at all. With one request outstanding the error can only be its.
+        if (it == pending_.end() && !error.empty() && pending_.size() == 1)
+        {
+            it = pending_.begin();
+            orphan = true;
+        }
+        if (it == pending_.end())
+            return;
+        pending = std::move(it->second);
+        pending_.erase(it);
+        for (const auto& id : pending.ids)
+            wire_.erase(id.first);
+    }
+
+    if (orphan)
+    {
+        std::exception_ptr failure;
+        try
+        {
+            throw JsonRPCException::from_json(
+                nlohmann::json::parse(error.begin(), error.end()));
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+        deliver(pending.handler, {}, failure);
+        return;
+    }
+
+    std::string response;
+    response.reserve(message.size());
+    size_t last = 0;
+    for (const auto& [begin, end] : spans)
+    {
+        uint64_t wire = parseWireId(message.substr(begin, end - begin));
+        for (const auto& id : pending.ids)
+        {
+            if (id.first != wire)
+                continue;
+            response.append(message, last, begin - last);
+            response += id.second;
+            last = end;
+            break;
+        }
+    }
+    response.append(message, last, std::string::npos);
+
+    deliver(pending.handler, std::move(response), nullptr);
+}
+
+void StreamConnector::onNotification(std::string_view params)
+{
+    std::string_view subscription, result;
+    scan::forEachMember(params, 0,
+                        [&](std::string_view key, size_t begin, size_t end)
+                        {
+                            auto value = params.substr(begin, end - begin);
+                            if (key == "subscription")
+                                subscription = scan::unquote(value);
+                            else if (key == "result")
+                                result = value;
+                            return true;
+                        });
+
+    std::shared_ptr<NotificationHandler> handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscriptions_.find(std::string(subscription));
+        if (it == subscriptions_.end())
+            return;
+        handler = it->second;
+    }
+
+    try
+    {
+        (*handler)(result);
+    }
+    catch (...)
+    {
+    }
+}
+
+}  // namespace web3::rpc
@@ -0,0 +1,349 @@
+#include "core/websocket.h"
+
+#include <cryptopp/base64.h>
+#include <cryptopp/filters.h>
+#include <cryptopp/sha.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+
+#include "core/error.h"
+
+namespace web3::rpc
+{
+
+namespace
+{
+
+constexpr const char* kAcceptGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+enum Opcode : uint8_t
+{
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+JsonRPCException connectionError(const std::string& what)
+{
+    return JsonRPCException(-32003, "Connection Error: " + what);
+}
+
+int connectTcp(const std::string& host, int port)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints,
+                    &result) != 0)
+        throw connectionError("could not resolve " + host);
+
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next)
+    {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+            break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0)
+        throw connectionError("could not connect to " + host + ":" +
+                              std::to_string(port));
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return fd;
+}
+
+std::string base64(const uint8_t* data, size_t size)
+{
+    std::string out;
+    CryptoPP::StringSource ss(
+        data, size, true,
+        new CryptoPP::Base64Encoder(new CryptoPP::StringSink(out), false));
+    return out;
+}
+
+std::string acceptKey(const std::string& key)
+{
+    std::string input = key + kAcceptGuid;
+    uint8_t digest[CryptoPP::SHA1::DIGESTSIZE];
+    CryptoPP::SHA1().CalculateDigest(
+        digest, reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    return base64(digest, sizeof(digest));
+}
+
+std::string lower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+}  // namespace
+
+WebSocketClient::WebSocketClient(const std::string& host, int port,
+                                 const std::string& path)
+    : fd_{connectTcp(host, port)},
+      maskRng_{std::random_device{}()},
+      offset_{0},
+      closing_{false},
+      maxMessageSize_{32 << 20}
+{
+    try
+    {
+        handshake(host, port, path);
+    }
+    catch (...)
+    {
+        close(fd_);
+        throw;
+    }
+    reader_ = std::thread(&WebSocketClient::run, this);
+}
+
+WebSocketClient::~WebSocketClient()
+{
+    closing_ = true;
+    try
+    {
+        const char status[2] = {0x03, static_cast<char>(0xE8)};  // 1000
+        sendFrame(CLOSE, status, sizeof(status));
+    }
+    catch (...)
+    {
+    }
+    shutdown(fd_, SHUT_RDWR);
+    reader_.join();
+    close(fd_);
+}
+
+void WebSocketClient::setMaxMessageSize(size_t bytes)
+{
+    maxMessageSize_ = bytes;
+}
+
+void WebSocketClient::write(const std::string& message)
+{
+    sendFrame(TEXT, message.data(), message.size());
+}
+
+void WebSocketClient::handshake(const std::string& host, int port,
+                                const std::string& path)
+{
+    uint8_t nonce[16];
+    for (auto& b : nonce)
+        b = static_cast<uint8_t>(maskRng_());
+    std::string key = base64(nonce, sizeof(nonce));
+
+    std::string request = "GET " + path +
+                          " HTTP/1.1\r\n"
+                          "Host: " +
+                          host + ":" + std::to_string(port) +
+                          "\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Key: " +
+                          key +
+                          "\r\n"
+                          "Sec-WebSocket-Version: 13\r\n\r\n";
+    sendAll(fd_, request.data(), request.size());
+
+    size_t end;
+    while ((end = buffer_.find("\r\n\r\n")) == std::string::npos)
+    {
+        char chunk[1024];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            throw connectionError("WebSocket handshake failed");
+        buffer_.append(chunk, n);
+    }
+
+    std::string header = lower(buffer_.substr(0, end));
+    offset_ = end + 4;
+
+    if (header.compare(0, 12, "http/1.1 101") != 0)
+        throw connectionError("WebSocket upgrade rejected: " +
+                              buffer_.substr(0, buffer_.find("\r\n")));
+
+    auto pos = header.find("\r\nsec-websocket-accept:");
+    if (pos == std::string::npos)
+        throw connectionError("WebSocket handshake missing accept key");
+
+    // Header values are case sensitive, so read this one from the original.
+    pos += std::strlen("\r\nsec-websocket-accept:");
+    auto valueEnd = buffer_.find("\r\n", pos);
+    std::string accept = buffer_.substr(pos, valueEnd - pos);
+    accept.erase(0, accept.find_first_not_of(" \t"));
+    accept.erase(accept.find_last_not_of(" \t") + 1);
+
+    if (accept != acceptKey(key))
+        throw connectionError("WebSocket handshake accept key mismatch");
+}
+
+void WebSocketClient::run()
+{
+    std::string message;
+    std::exception_ptr error;
+    try
+    {
+        while (true)
+        {
+            uint8_t head[2];
+            readExact(reinterpret_cast<char*>(head), 2);
+
+            bool fin = head[0] & 0x80;
+            uint8_t opcode = head[0] & 0x0F;
+            bool masked = head[1] & 0x80;
+            uint64_t size = head[1] & 0x7F;
+
+            if (size == 126 || size == 127)
+            {
+                uint8_t ext[8];
+                size_t n = size == 126 ? 2 : 8;
+                readExact(reinterpret_cast<char*>(ext), n);
+                size = 0;
+                for (size_t i = 0; i < n; i++)
+                    size = (size << 8) | ext[i];
+            }
+
+            uint8_t mask[4] = {0, 0, 0, 0};
+            if (masked)
+                readExact(reinterpret_cast<char*>(mask), 4);
+
+            // Checked before the payload is allocated, so a bogus length
+            // cannot exhaust memory.
+            size_t limit = maxMessageSize_;
+            size_t used = opcode == CONTINUATION ? message.size() : 0;
+            if (size > limit - std::min(used, limit))
+            {
+                const char status[2] = {0x03, static_cast<char>(0xF1)};  // 1009
+                sendFrame(CLOSE, status, sizeof(status));
+                shutdown(fd_, SHUT_WR);
+                throw connectionError("WebSocket message exceeds " +
+                                      std::to_string(limit) + " bytes");
+            }
+
+            std::string payload(size, '\0');
+            readExact(payload.data(), size);
+            if (masked)
+                for (size_t i = 0; i < size; i++)
+                    payload[i] ^= mask[i & 3];
+
+            switch (opcode)
+            {
+                case TEXT:
+                case BINARY:
+                    message = std::move(payload);
+                    break;
+                case CONTINUATION:
+                    message += payload;
+                    break;
+                case PING:
+                    sendFrame(PONG, payload.data(), payload.size());
+                    continue;
+                case PONG:
+                    continue;
+                case CLOSE:
+                    if (!closing_)
+                        sendFrame(CLOSE, payload.data(),
+                                  std::min<size_t>(payload.size(), 2));
+                    throw connectionError("WebSocket closed by peer");
+                default:
+                    throw connectionError("Unknown WebSocket opcode");
+            }
+
+            if (fin)
+                onMessage(message);
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    if (closing_)
+        error = std::make_exception_ptr(
+            connectionError("WebSocket connector shut down"));
+    onClose(error);
+}
+
+void WebSocketClient::sendFrame(uint8_t opcode, const char* payload,
+                                size_t size)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+
+    std::string frame;
+    frame.reserve(size + 14);
+    frame.push_back(static_cast<char>(0x80 | opcode));
+    if (size < 126)
+    {
+        frame.push_back(static_cast<char>(0x80 | size));
+    }
+    else if (size <= 0xFFFF)
+    {
+        frame.push_back(static_cast<char>(0x80 | 126));
+        frame.push_back(static_cast<char>(size >> 8));
+        frame.push_back(static_cast<char>(size));
+    }
+    else
+    {
+        frame.push_back(static_cast<char>(0x80 | 127));
+        for (int shift = 56; shift >= 0; shift -= 8)
+            frame.push_back(static_cast<char>(uint64_t(size) >> shift));
+    }
+
+    uint32_t key = maskRng_();
+    char mask[4];
+    std::memcpy(mask, &key, 4);
+    frame.append(mask, 4);
+
+    size_t start = frame.size();
+    frame.append(payload, size);
+    for (size_t i = 0; i < size; i++)
+        frame[start + i] ^= mask[i & 3];
+
+    sendAll(fd_, frame.data(), frame.size());
+}
+
+void WebSocketClient::readExact(char* out, size_t size)
+{
+    while (buffer_.size() - offset_ < size)
+    {
+        if (offset_ > 0)
+        {
+            buffer_.erase(0, offset_);
+            offset_ = 0;
+        }
+        char chunk[16384];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            throw connectionError(n == 0 ? "WebSocket connection closed"
+                                         : std::strerror(errno));
+        buffer_.append(chunk, n);
+    }
+    std::memcpy(out, buffer_.data() + offset_, size);
+    offset_ += size;
+}
+
+}  // namespace web3::rpc
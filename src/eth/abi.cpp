@@ -0,0 +1,982 @@
+#include "eth/abi.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "utils/hex.h"
+
+namespace web3::eth::abi
+{
+
+namespace
+{
+
+[[noreturn]] void fail(const std::string& message)
+{
+    throw std::runtime_error("ABI: " + message);
+}
+
+size_t parseCount(std::string_view digits, std::string_view text)
+{
+    if (digits.empty() || digits.size() > 9)
+        fail("invalid size in type " + std::string(text));
+    size_t n = 0;
+    for (char c : digits)
+    {
+        if (c < '0' || c > '9')
+            fail("invalid size in type " + std::string(text));
+        n = n * 10 + (c - '0');
+    }
+    return n;
+}
+
+Type parseElementary(std::string_view name, std::string_view text)
+{
+    auto sized = [&](size_t prefix, size_t fallback)
+    {
+        auto digits = name.substr(prefix);
+        return digits.empty() ? fallback : parseCount(digits, text);
+    };
+
+    if (name == "address")
+        return Type::elementary(Kind::Address);
+    if (name == "bool")
+        return Type::elementary(Kind::Bool);
+    if (name == "string")
+        return Type::elementary(Kind::String);
+    if (name == "bytes")
+        return Type::elementary(Kind::Bytes);
+    if (name == "function")
+    {
+        Type t = Type::elementary(Kind::FixedBytes, 24);
+        t.function = true;
+        return t;
+    }
+
+    if (name.substr(0, 5) == "bytes")
+    {
+        size_t size = sized(5, 0);
+        if (size < 1 || size > 32)
+            fail("invalid type " + std::string(text));
+        return Type::elementary(Kind::FixedBytes, size);
+    }
+
+    bool isSigned = name.substr(0, 3) == "int";
+    if (isSigned || name.substr(0, 4) == "uint")
+    {
+        size_t bits = sized(isSigned ? 3 : 4, 256);
+        if (bits < 8 || bits > 256 || bits % 8)
+            fail("invalid type " + std::string(text));
+        return Type::elementary(isSigned ? Kind::Int : Kind::Uint, bits);
+    }
+
+    fail("unknown type " + std::string(text));
+}
+
+// Wraps t in the array suffixes at the start of rest, e.g. "[2][]".
+Type parseSuffixes(Type t, std::string_view& rest, std::string_view text)
+{
+    while (!rest.empty() && rest[0] == '[')
+    {
+        size_t close = rest.find(']');
+        if (close == std::string_view::npos)
+            fail("unterminated array in type " + std::string(text));
+        auto digits = rest.substr(1, close - 1);
+        t = digits.empty()
+                ? Type::array(std::move(t))
+                : Type::fixedArray(std::move(t), parseCount(digits, text));
+        rest.remove_prefix(close + 1);
+    }
+    return t;
+}
+
+Type parseType(std::string_view& rest, std::string_view text)
+{
+    Type t;
+    if (!rest.empty() && rest[0] == '(')
+    {
+        rest.remove_prefix(1);
+        std::vector<Type> members;
+        if (!rest.empty() && rest[0] == ')')
+            rest.remove_prefix(1);
+        else
+            for (;;)
+            {
+                members.push_back(parseType(rest, text));
+                if (rest.empty())
+                    fail("unterminated tuple in type " + std::string(text));
+                char c = rest[0];
+                rest.remove_prefix(1);
+                if (c == ')')
+                    break;
+                if (c != ',')
+                    fail("unexpected '" + std::string(1, c) + "' in type " +
+                         std::string(text));
+            }
+        t = Type::tuple(std::move(members));
+    }
+    else
+    {
+        size_t end = 0;
+        while (end < rest.size() && rest[end] != '[' && rest[end] != ',' &&
+               rest[end] != ')')
+            end++;
+        t = parseElementary(rest.substr(0, end), text);
+        rest.remove_prefix(end);
+    }
+    return parseSuffixes(std::move(t), rest, text);
+}
+
+// Encoding works on sequences: the members of a tuple, or the elements of
+// an array. Heads come first, in order; every dynamic item puts the offset
+// of its tail, relative to the start of the sequence, in its head.
+
+const Type& itemType(const Type& seq, size_t i)
+{
+    return seq.kind == Kind::Tuple ? seq.components[i] : seq.components[0];
+}
+
+size_t headsSize(const Type& seq, size_t count)
+{
+    if (seq.kind != Kind::Tuple)
+        return count * seq.components[0].headSize;
+    size_t size = 0;
+    for (const auto& member : seq.components)
+        size += member.headSize;
+    return size;
+}
+
+const Value::Array& sequenceValues(const Type& seq, const Value& value)
+{
+    if (!value.is<Value::Array>())
+        fail("expected an array or tuple value for " + seq.canonical());
+    const auto& items = value.toArray();
+    size_t expected = seq.kind == Kind::Tuple ? seq.components.size()
+                      : seq.kind == Kind::FixedArray ? seq.size
+                                                     : items.size();
+    if (items.size() != expected)
+        fail("expected " + std::to_string(expected) + " values for " +
+             seq.canonical() + ", got " + std::to_string(items.size()));
+    return items;
+}
+
+size_t sequenceSize(const Type& seq, const Value::Array& items)
+{
+    size_t size = headsSize(seq, items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const Type& t = itemType(seq, i);
+        if (t.dynamic)
+            size += encodedSize(t, items[i]);
+    }
+    return size;
+}
+
+size_t padded(size_t size)
+{
+    return (size + 31) / 32 * 32;
+}
+
+// Payload of a bytes, bytesN or string value. Text is hex for the bytes
+// types, so its size is half the digits.
+size_t byteCount(const Type& t, const Value& value)
+{
+    if (value.is<type::bytes>())
+        return value.toBytes().size();
+    if (!value.is<std::string>())
+        fail("expected bytes for " + t.canonical());
+    if (t.kind == Kind::String)
+        return value.toString().size();
+    auto digits = utils::hex::stripPrefix(value.toString());
+    if (digits.size() % 2)
+        fail("odd length hex for " + t.canonical());
+    return digits.size() / 2;
+}
+
+void writeByteData(const Type& t, const Value& value, uint8_t* out)
+{
+    if (value.is<type::bytes>())
+    {
+        const auto& data = value.toBytes();
+        if (!data.empty())
+            std::memcpy(out, data.data(), data.size());
+        return;
+    }
+    const auto& text = value.toString();
+    if (t.kind == Kind::String)
+    {
+        std::memcpy(out, text.data(), text.size());
+        return;
+    }
+    auto digits = utils::hex::stripPrefix(text);
+    if (!utils::hex::decode(digits.data(), digits.size(), out))
+        fail("invalid hex for " + t.canonical() + ": " + text);
+}
+
+void writeWord(uint8_t* out, const type::uint256& value)
+{
+    auto be = value.toBytes();
+    std::memcpy(out, be.data(), 32);
+}
+
+type::uint256 integer(const Type& t, const Value& value)
+{
+    type::uint256 x;
+    if (value.is<type::uint256>())
+    {
+        x = value.toUint256();
+    }
+    else if (value.is<std::string>())
+    {
+        std::string_view text = value.toString();
+        bool negative = t.kind == Kind::Int && !text.empty() && text[0] == '-';
+        if (negative)
+            text.remove_prefix(1);
+        x = type::uint256::parse(text);
+        if (negative)
+            x = type::uint256() - x;
+    }
+    else
+    {
+        fail("expected an integer for " + t.canonical());
+    }
+
+    if (t.size < 256)
+    {
+        // Unsigned values must fit; signed ones must be the sign extension
+        // of their low bits.
+        type::uint256 high = t.kind == Kind::Uint ? x >> t.size
+                                                  : x >> (t.size - 1);
+        bool fits = high.isZero() ||
+                    (t.kind == Kind::Int && high == ~type::uint256() >>
+                                                        (t.size - 1));
+        if (!fits)
+            fail("value out of range for " + t.canonical());
+    }
+    return x;
+}
+
+uint8_t* write(const Type& t, const Value& value, uint8_t* out);
+
+uint8_t* writeSequence(const Type& seq, const Value::Array& items,
+                       uint8_t* out)
+{
+    uint8_t* head = out;
+    uint8_t* tail = out + headsSize(seq, items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const Type& t = itemType(seq, i);
+        if (t.dynamic)
+        {
+            writeWord(head, type::uint256(static_cast<uint64_t>(tail - out)));
+            tail = write(t, items[i], tail);
+            head += 32;
+        }
+        else
+        {
+            write(t, items[i], head);
+            head += t.headSize;
+        }
+    }
+    return tail;
+}
+
+// Writes value and returns the end of what was written.
+uint8_t* write(const Type& t, const Value& value, uint8_t* out)
+{
+    switch (t.kind)
+    {
+        case Kind::Uint:
+        case Kind::Int:
+            writeWord(out, integer(t, value));
+            return out + 32;
+        case Kind::Address:
+        {
+            type::address a = value.is<std::string>()
+                                   ? type::address(value.toString())
+                                   : value.toAddress();
+            std::memset(out, 0, 12);
+            std::memcpy(out + 12, a.bytes.data(), 20);
+            return out + 32;
+        }
+        case Kind::Bool:
+        {
+            bool b;
+            if (value.is<std::string>())
+            {
+                const auto& text = value.toString();
+                if (text != "true" && text != "false")
+                    fail("expected a bool, got " + text);
+                b = text == "true";
+            }
+            else
+                b = value.toBool();
+            std::memset(out, 0, 32);
+            out[31] = b;
+            return out + 32;
+        }
+        case Kind::FixedBytes:
+        {
+            size_t size = byteCount(t, value);
+            if (size > t.size)
+                fail("too many bytes for " + t.canonical());
+            std::memset(out, 0, 32);
+            writeByteData(t, value, out);
+            return out + 32;
+        }
+        case Kind::Bytes:
+        case Kind::String:
+        {
+            size_t size = byteCount(t, value);
+            writeWord(out, type::uint256(static_cast<uint64_t>(size)));
+            std::memset(out + 32, 0, padded(size));
+            writeByteData(t, value, out + 32);
+            return out + 32 + padded(size);
+        }
+        case Kind::Array:
+        {
+            const auto& items = sequenceValues(t, value);
+            writeWord(out, type::uint256(static_cast<uint64_t>(items.size())));
+            return writeSequence(t, items, out + 32);
+        }
+        case Kind::FixedArray:
+        case Kind::Tuple:
+            return writeSequence(t, sequenceValues(t, value), out);
+    }
+    return out;
+}
+
+uint64_t topicKey(const uint8_t* topic)
+{
+    uint64_t key;
+    std::memcpy(&key, topic, sizeof(key));
+    return key;
+}
+
+uint32_t selectorKey(const uint8_t* selector)
+{
+    uint32_t key;
+    std::memcpy(&key, selector, sizeof(key));
+    return key;
+}
+
+Type parametersFromJson(const nlohmann::json& params)
+{
+    std::vector<Type> types;
+    std::vector<std::string> names;
+    for (const auto& param : params)
+    {
+        types.push_back(Type::fromJson(param));
+        names.push_back(param.value("name", ""));
+    }
+    return Type::tuple(std::move(types), std::move(names));
+}
+
+}  // namespace
+
+Type Type::elementary(Kind kind, size_t size)
+{
+    Type t;
+    t.kind = kind;
+    t.size = size;
+    t.layout();
+    return t;
+}
+
+Type Type::array(Type element)
+{
+    Type t;
+    t.kind = Kind::Array;
+    t.components.push_back(std::move(element));
+    t.layout();
+    return t;
+}
+
+Type Type::fixedArray(Type element, size_t length)
+{
+    Type t;
+    t.kind = Kind::FixedArray;
+    t.size = length;
+    t.components.push_back(std::move(element));
+    t.layout();
+    return t;
+}
+
+Type Type::tuple(std::vector<Type> members, std::vector<std::string> names)
+{
+    Type t;
+    t.kind = Kind::Tuple;
+    t.components = std::move(members);
+    t.names = std::move(names);
+    t.layout();
+    return t;
+}
+
+void Type::layout()
+{
+    switch (kind)
+    {
+        case Kind::Bytes:
+        case Kind::String:
+        case Kind::Array:
+            dynamic = true;
+            headSize = 32;
+            break;
+        case Kind::FixedArray:
+            dynamic = components[0].dynamic;
+            headSize = dynamic ? 32 : size * components[0].headSize;
+            break;
+        case Kind::Tuple:
+            dynamic = false;
+            headSize = 0;
+            for (const auto& member : components)
+            {
+                dynamic = dynamic || member.dynamic;
+                headSize += member.headSize;
+            }
+            if (dynamic)
+                headSize = 32;
+            break;
+        default:
+            dynamic = false;
+            headSize = 32;
+            break;
+    }
+}
+
+Type Type::parse(std::string_view text)
+{
+    std::string_view rest = text;
+    Type t = parseType(rest, text);
+    if (!rest.empty())
+        fail("trailing characters in type " + std::string(text));
+    return t;
+}
+
+Type Type::fromJson(const nlohmann::json& param)
+{
+    std::string text = param.at("type").get<std::string>();
+    if (text.compare(0, 5, "tuple") != 0)
+        return parse(text);
+
+    Type t = parametersFromJson(
+        param.value("components", nlohmann::json::array()));
+    std::string_view rest = std::string_view(text).substr(5);
+    t = parseSuffixes(std::move(t), rest, text);
+    if (!rest.empty())
+        fail("trailing characters in type " + text);
+    return t;
+}
+
+std::string Type::canonical() const
+{
+    switch (kind)
+    {
+        case Kind::Uint:
+            return "uint" + std::to_string(size);
+        case Kind::Int:
+            return "int" + std::to_string(size);
+        case Kind::Address:
+            return "address";
+        case Kind::Bool:
+            return "bool";
+        case Kind::FixedBytes:
+            return function ? "function" : "bytes" + std::to_string(size);
+        case Kind::Bytes:
+            return "bytes";
+        case Kind::String:
+            return "string";
+        case Kind::Array:
+            return components[0].canonical() + "[]";
+        case Kind::FixedArray:
+            return components[0].canonical() + "[" + std::to_string(size) +
+                   "]";
+        case Kind::Tuple:
+        {
+            std::string out = "(";
+            for (size_t i = 0; i < components.size(); i++)
+            {
+                if (i)
+                    out += ',';
+                out += components[i].canonical();
+            }
+            return out + ")";
+        }
+    }
+    return {};
+}
+
+size_t encodedSize(const Type& type, const Value& value)
+{
+    switch (type.kind)
+    {
+        case Kind::Bytes:
+        case Kind::String:
+            return 32 + padded(byteCount(type, value));
+        case Kind::Array:
+            return 32 + sequenceSize(type, sequenceValues(type, value));
+        case Kind::FixedArray:
+        case Kind::Tuple:
+            return sequenceSize(type, sequenceValues(type, value));
+        default:
+            return 32;
+    }
+}
+
+void encode(const Type& type, const Value& value, uint8_t* out)
+{
+    write(type, value, out);
+}
+
+type::bytes encode(const Type& type, const Value& value)
+{
+    type::bytes out(encodedSize(type, value));
+    write(type, value, out.data());
+    return out;
+}
+
+namespace
+{
+
+// Reads a word that holds an offset or a length.
+size_t readSize(const uint8_t* p, const uint8_t* end)
+{
+    if (end - p < 32)
+        fail("data too short");
+    for (size_t i = 0; i < 24; i++)
+        if (p[i])
+            fail("offset or length too large");
+    size_t n = 0;
+    for (size_t i = 24; i < 32; i++)
+        n = n << 8 | p[i];
+    return n;
+}
+
+// Input i of an indexed dynamic type reads as its hash.
+const Type& hashType()
+{
+    static const Type type = Type::elementary(Kind::FixedBytes, 32);
+    return type;
+}
+
+size_t memberIndex(const Type& tuple, std::string_view name)
+{
+    if (tuple.kind != Kind::Tuple)
+        fail("not a tuple: " + tuple.canonical());
+    for (size_t i = 0; i < tuple.names.size(); i++)
+        if (tuple.names[i] == name)
+            return i;
+    throw std::out_of_range("ABI: no member " + std::string(name));
+}
+
+}  // namespace
+
+const uint8_t* View::word() const
+{
+    if (end_ - at_ < 32)
+        fail("data too short");
+    return at_;
+}
+
+type::uint256 View::toUint256() const
+{
+    if (type_->kind != Kind::Uint && type_->kind != Kind::Int)
+        fail("not an integer: " + type_->canonical());
+    auto x = type::uint256::fromBytes(word(), 32);
+    if (type_->size < 256)
+    {
+        // Reject words with dirty high bits, as Solidity does.
+        type::uint256 high = type_->kind == Kind::Uint
+                                 ? x >> type_->size
+                                 : x >> (type_->size - 1);
+        if (!high.isZero() &&
+            !(type_->kind == Kind::Int &&
+              high == ~type::uint256() >> (type_->size - 1)))
+            fail("integer out of range for " + type_->canonical());
+    }
+    return x;
+}
+
+uint64_t View::toU64() const
+{
+    auto x = toUint256();
+    if (x.bitLength() > 64)
+        fail("integer does not fit in 64 bits");
+    return x.toU64();
+}
+
+type::address View::toAddress() const
+{
+    if (type_->kind != Kind::Address)
+        fail("not an address: " + type_->canonical());
+    const uint8_t* w = word();
+    for (size_t i = 0; i < 12; i++)
+        if (w[i])
+            fail("address with dirty high bytes");
+    type::address a;
+    std::memcpy(a.bytes.data(), w + 12, 20);
+    return a;
+}
+
+bool View::toBool() const
+{
+    if (type_->kind != Kind::Bool)
+        fail("not a bool: " + type_->canonical());
+    const uint8_t* w = word();
+    for (size_t i = 0; i < 31; i++)
+        if (w[i])
+            fail("invalid bool");
+    if (w[31] > 1)
+        fail("invalid bool");
+    return w[31];
+}
+
+std::string_view View::bytes() const
+{
+    const char* base = reinterpret_cast<const char*>(at_);
+    switch (type_->kind)
+    {
+        case Kind::FixedBytes:
+            return std::string_view(reinterpret_cast<const char*>(word()),
+                                    type_->size);
+        case Kind::Bytes:
+        case Kind::String:
+        {
+            size_t size = readSize(at_, end_);
+            if (size > static_cast<size_t>(end_ - at_) - 32)
+                fail("data too short");
+            return std::string_view(base + 32, size);
+        }
+        default:
+            fail("not bytes or string: " + type_->canonical());
+    }
+}
+
+size_t View::length() const
+{
+    switch (type_->kind)
+    {
+        case Kind::Array:
+        {
+            size_t count = readSize(at_, end_);
+            // Every element takes at least a word, bar empty tuples; cap
+            // the count by the data so a bogus length cannot run away.
+            size_t unit = std::max<size_t>(type_->components[0].headSize, 1);
+            if (count > (static_cast<size_t>(end_ - at_) - 32) / unit)
+                fail("array length exceeds data");
+            return count;
+        }
+        case Kind::FixedArray:
+            return type_->size;
+        case Kind::Tuple:
+            return type_->components.size();
+        default:
+            fail("not an array or tuple: " + type_->canonical());
+    }
+}
+
+View View::operator[](size_t index) const
+{
+    size_t count = length();
+    if (index >= count)
+        throw std::out_of_range("ABI: index out of range");
+
+    const uint8_t* seq = type_->kind == Kind::Array ? at_ + 32 : at_;
+    const Type& t = itemType(*type_, index);
+    size_t head = 0;
+    if (type_->kind == Kind::Tuple)
+        for (size_t i = 0; i < index; i++)
+            head += type_->components[i].headSize;
+    else
+        head = index * t.headSize;
+
+    if (static_cast<size_t>(end_ - seq) < head + (t.dynamic ? 32 : t.headSize))
+        fail("data too short");
+    if (!t.dynamic)
+        return View(t, seq + head, end_);
+
+    size_t offset = readSize(seq + head, end_);
+    if (offset > static_cast<size_t>(end_ - seq))
+        fail("offset out of range");
+    return View(t, seq + offset, end_);
+}
+
+View View::operator[](std::string_view name) const
+{
+    return (*this)[memberIndex(*type_, name)];
+}
+
+Value View::toValue() const
+{
+    switch (type_->kind)
+    {
+        case Kind::Uint:
+        case Kind::Int:
+            return toUint256();
+        case Kind::Address:
+            return toAddress();
+        case Kind::Bool:
+            return toBool();
+        case Kind::FixedBytes:
+        case Kind::Bytes:
+        {
+            auto data = bytes();
+            return type::bytes(data.begin(), data.end());
+        }
+        case Kind::String:
+            return std::string(bytes());
+        default:
+        {
+            size_t count = length();
+            Value::Array items;
+            items.reserve(count);
+            for (size_t i = 0; i < count; i++)
+                items.push_back((*this)[i].toValue());
+            return items;
+        }
+    }
+}
+
+Value decode(const Type& type, const uint8_t* data, size_t size)
+{
+    return View(type, data, size).toValue();
+}
+
+LogView::LogView(const Event& event, const utils::Hash256* topics,
+                 size_t topicCount, const uint8_t* data, size_t size)
+    : event_(&event), topics_(topics), data_(event.data, data, size)
+{
+    size_t expected = event.topicCount();
+    if (topicCount != expected)
+        fail(event.name + " takes " + std::to_string(expected) +
+             " topics, got " + std::to_string(topicCount));
+    if (!event.anonymous && topics[0] != event.topic0)
+        fail("log is not a " + event.name + " event");
+}
+
+View LogView::operator[](size_t index) const
+{
+    if (index >= length())
+        throw std::out_of_range("ABI: index out of range");
+    size_t position = event_->positions[index];
+    if (!event_->indexed[index])
+        return data_[position];
+
+    const Type& t = event_->inputs.components[index];
+    const Type& shown = t.dynamic || t.kind == Kind::FixedArray ||
+                                t.kind == Kind::Tuple
+                            ? hashType()
+                            : t;
+    return View(shown, topics_[position].data(), 32);
+}
+
+View LogView::operator[](std::string_view name) const
+{
+    return (*this)[memberIndex(event_->inputs, name)];
+}
+
+Value::Array LogView::toValues() const
+{
+    Value::Array values;
+    values.reserve(length());
+    for (size_t i = 0; i < length(); i++)
+        values.push_back((*this)[i].toValue());
+    return values;
+}
+
+void RawLog::assign(const type::response::Log& log)
+{
+    auto decodeInto = [](std::string_view text, uint8_t* out, size_t size)
+    {
+        auto digits = utils::hex::stripPrefix(text);
+        if (digits.size() != 2 * size ||
+            !utils::hex::decode(digits.data(), digits.size(), out))
+            fail("invalid hex in log: " + std::string(text));
+    };
+
+    address = log.address.empty() ? type::address()
+                                  : type::address(log.address);
+    topics.resize(log.topics.size());
+    for (size_t i = 0; i < topics.size(); i++)
+        decodeInto(log.topics[i], topics[i].data(), 32);
+    data.resize(utils::hex::stripPrefix(log.data).size() / 2);
+    decodeInto(log.data, data.data(), data.size());
+}
+
+Function Function::fromJson(const nlohmann::json& item)
+{
+    Function f;
+    f.name = item.value("name", "");
+    f.inputs =
+        parametersFromJson(item.value("inputs", nlohmann::json::array()));
+    f.outputs =
+        parametersFromJson(item.value("outputs", nlohmann::json::array()));
+    f.signature = f.name + f.inputs.canonical();
+
+    // ABIs from before Solidity 0.5 only have the constant flag.
+    if (item.contains("stateMutability"))
+        f.stateMutability = item["stateMutability"].get<std::string>();
+    else
+        f.stateMutability =
+            item.value("constant", false) ? "view" : "nonpayable";
+
+    auto hash = utils::Keccak256::hash(f.signature);
+    std::memcpy(f.selector.data(), hash.data(), f.selector.size());
+    return f;
+}
+
+type::bytes Function::encodeCall(const Value::Array& args) const
+{
+    if (args.size() != inputs.components.size())
+        fail(signature + " takes " + std::to_string(inputs.components.size()) +
+             " arguments, got " + std::to_string(args.size()));
+
+    type::bytes out(selector.size() + sequenceSize(inputs, args));
+    std::memcpy(out.data(), selector.data(), selector.size());
+    writeSequence(inputs, args, out.data() + selector.size());
+    return out;
+}
+
+size_t Event::topicCount() const
+{
+    size_t count = anonymous ? 0 : 1;
+    for (bool i : indexed)
+        count += i;
+    return count;
+}
+
+Event Event::fromJson(const nlohmann::json& item)
+{
+    Event e;
+    e.name = item.value("name", "");
+    e.anonymous = item.value("anonymous", false);
+    auto inputs = item.value("inputs", nlohmann::json::array());
+    e.inputs = parametersFromJson(inputs);
+    for (const auto& input : inputs)
+        e.indexed.push_back(input.value("indexed", false));
+    e.signature = e.name + e.inputs.canonical();
+    e.topic0 = utils::Keccak256::hash(e.signature);
+
+    std::vector<Type> data;
+    std::vector<std::string> names;
+    size_t topic = e.anonymous ? 0 : 1;
+    for (size_t i = 0; i < e.indexed.size(); i++)
+    {
+        if (e.indexed[i])
+        {
+            e.positions.push_back(topic++);
+            continue;
+        }
+        e.positions.push_back(data.size());
+        data.push_back(e.inputs.components[i]);
+        names.push_back(e.inputs.names[i]);
+    }
+    e.data = Type::tuple(std::move(data), std::move(names));
+    return e;
+}
+
+Interface::Interface(const nlohmann::json& abi)
+{
+    for (const auto& item : abi)
+    {
+        // The type defaults to function.
+        std::string kind = item.value("type", "function");
+        if (kind == "function")
+            functions_.push_back(Function::fromJson(item));
+        else if (kind == "event")
+            events_.push_back(Event::fromJson(item));
+        else if (kind == "constructor")
+            constructor_ = parametersFromJson(
+                item.value("inputs", nlohmann::json::array()));
+    }
+
+    // Indexed only once the vectors are complete, so pointers stay valid.
+    for (const auto& f : functions_)
+    {
+        byName_[f.name].push_back(&f);
+        bySignature_.emplace(f.signature, &f);
+        bySelector_.emplace(selectorKey(f.selector.data()), &f);
+    }
+    for (const auto& e : events_)
+    {
+        eventsByName_.emplace(e.name, &e);
+        if (!e.anonymous)
+            byTopic_.emplace(topicKey(e.topic0.data()), &e);
+    }
+}
+
+const std::vector<const Function*>& Interface::overloads(
+    const std::string& name) const
+{
+    static const std::vector<const Function*> none;
+    auto it = byName_.find(name);
+    return it == byName_.end() ? none : it->second;
+}
+
+const Function& Interface::function(const std::string& name) const
+{
+    if (name.find('(') != std::string::npos)
+    {
+        auto it = bySignature_.find(name);
+        if (it == bySignature_.end())
+            throw std::out_of_range("ABI: no function " + name);
+        return *it->second;
+    }
+
+    const auto& candidates = overloads(name);
+    if (candidates.empty())
+        throw std::out_of_range("ABI: no function " + name);
+    if (candidates.size() > 1)
+        fail(name + " is overloaded; use its full signature");
+    return *candidates[0];
+}
+
+const Function& Interface::function(const std::string& name,
+                                    size_t argCount) const
+{
+    if (name.find('(') != std::string::npos)
+        return function(name);
+    for (const Function* f : overloads(name))
+        if (f->inputs.components.size() == argCount)
+            return *f;
+    throw std::out_of_range("ABI: no function " + name + " taking " +
+                            std::to_string(argCount) + " arguments");
+}
+
+const Function* Interface::findSelector(const uint8_t* selector) const
+{
+    auto it = bySelector_.find(selectorKey(selector));
+    return it == bySelector_.end() ? nullptr : it->second;
+}
+
+const Event& Interface::event(const std::string& name) const
+{
+    auto it = eventsByName_.find(name);
+    if (it == eventsByName_.end())
+        throw std::out_of_range("ABI: no event " + name);
+    return *it->second;
+}
+
+const Event* Interface::findTopic(const utils::Hash256& topic0) const
+{
+    auto it = byTopic_.find(topicKey(topic0.data()));
+    if (it == byTopic_.end() || it->second->topic0 != topic0)
+        return nullptr;
+    return it->second;
+}
+
+std::optional<LogView> Interface::decodeLog(const RawLog& log) const
+{
+    if (log.topics.empty())
+        return std::nullopt;
+    const Event* event = findTopic(log.topics[0]);
+    // A matching first topic with the wrong number of others is a different
+    // event sharing the signature, with other parameters indexed.
+    if (!event || log.topics.size() != event->topicCount())
+        return std::nullopt;
+    return LogView(*event, log.topics.data(), log.topics.size(),
+                   log.data.data(), log.data.size());
+}
+
+}  // namespace web3::eth::abi
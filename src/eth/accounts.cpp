@@ -0,0 +1,141 @@
+#include "eth/accounts.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace web3::eth
+{
+
+uint64_t Wallet::hash(const type::address& address)
+{
+    uint64_t head = 0, tail = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        head = head << 8 | address.bytes[i];
+        tail = tail << 8 | address.bytes[12 + i];
+    }
+    // Addresses are mostly hash output already, but vanity prefixes are
+    // common, so both ends are mixed in.
+    uint64_t h = (head ^ (tail << 32 | tail >> 32)) * 0x9e3779b97f4a7c15ULL;
+    return h ^ h >> 32;
+}
+
+size_t Wallet::probe(const type::address& address) const
+{
+    size_t mask = slots_.size() - 1;
+    size_t i = hash(address) & mask;
+    while (slots_[i] && slots_[i]->address != address)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void Wallet::grow()
+{
+    std::vector<std::shared_ptr<const Account>> old(
+        slots_.empty() ? 16 : slots_.size() * 2);
+    old.swap(slots_);
+    for (auto& account : old)
+        if (account)
+        {
+            size_t i = probe(account->address);
+            slots_[i] = std::move(account);
+        }
+}
+
+void Wallet::add(const Account& account)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Keep the load factor under 3/4 so probe sequences stay short.
+    if ((count_ + 1) * 4 > slots_.size() * 3)
+        grow();
+
+    size_t i = probe(account.address);
+    if (!slots_[i])
+        count_++;
+    slots_[i] = std::make_shared<const Account>(account);
+}
+
+bool Wallet::remove(const type::address& address)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (slots_.empty())
+        return false;
+
+    size_t i = probe(address);
+    if (!slots_[i])
+        return false;
+    slots_[i].reset();
+    count_--;
+
+    // Shift later members of the probe run back into the hole, so lookups
+    // never need tombstones.
+    size_t mask = slots_.size() - 1;
+    for (size_t j = (i + 1) & mask; slots_[j]; j = (j + 1) & mask)
+    {
+        size_t home = hash(slots_[j]->address) & mask;
+        bool stays = i <= j ? i < home && home <= j : i < home || home <= j;
+        if (!stays)
+        {
+            slots_[i] = std::move(slots_[j]);
+            i = j;
+        }
+    }
+    return true;
+}
+
+void Wallet::clear()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    slots_.clear();
+    count_ = 0;
+}
+
+size_t Wallet::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return count_;
+}
+
+std::shared_ptr<const Account> Wallet::find(
+    const type::address& address) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (slots_.empty())
+        return nullptr;
+    return slots_[probe(address)];
+}
+
+std::shared_ptr<const Account> Wallet::get(
+    const type::address& address) const
+{
+    auto account = find(address);
+    if (!account)
+        throw std::out_of_range("Account not found: " + address.toHex());
+    return account;
+}
+
+Account Accounts::create()
+{
+    return privateKeyToAccount(utils::generatePrivateKey());
+}
+
+Account Accounts::privateKeyToAccount(const std::string& privateKey)
+{
+    return Account(utils::privateKeyToAddress(privateKey), privateKey);
+}
+
+std::string Accounts::signTransaction(const type::request::Transaction& tx,
+                                      const std::string& privateKey)
+{
+    return utils::bytesToHex(utils::sign::signTransaction(tx, privateKey));
+}
+
+std::string Accounts::signTransaction(const type::request::Transaction& tx,
+                                      const Account& account)
+{
+    return utils::bytesToHex(
+        utils::sign::signTransaction(tx, account.secretKey));
+}
+
+}  // namespace web3::eth
@@ -0,0 +1,277 @@
+#include "eth/block_cache.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "types/compact.h"
+
+namespace web3::eth
+{
+
+using type::response::Block;
+
+namespace
+{
+
+std::string lower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+std::string entryKey(const std::string& hash, bool full)
+{
+    return lower(hash) + (full ? "/full" : "/header");
+}
+
+size_t footprint(std::initializer_list<const std::string*> strings)
+{
+    size_t bytes = 0;
+    for (const std::string* s : strings)
+        bytes += s->size();
+    return bytes;
+}
+
+size_t footprint(const std::vector<std::string>& strings)
+{
+    size_t bytes = strings.size() * sizeof(std::string);
+    for (const auto& s : strings)
+        bytes += s.size();
+    return bytes;
+}
+
+// Approximate heap and inline size; the exact figure does not matter, only
+// that the budget tracks it.
+size_t footprint(const Block& b)
+{
+    size_t bytes =
+        sizeof(b) + footprint({&b.hash, &b.parentHash, &b.sha3Uncles,
+                               &b.miner, &b.stateRoot, &b.transactionsRoot,
+                               &b.receiptsRoot, &b.logsBloom, &b.difficulty,
+                               &b.number, &b.gasLimit, &b.gasUsed,
+                               &b.timestamp, &b.extraData, &b.mixHash,
+                               &b.nonce, &b.baseFeePerGas, &b.withdrawalsRoot,
+                               &b.size}) +
+        footprint(b.transactionHashes) + footprint(b.uncles);
+
+    for (const auto& t : b.transactions)
+    {
+        bytes += sizeof(t) +
+                 footprint({&t.blockHash, &t.blockNumber, &t.from,
+                            &t.transactionIndex, &t.type, &t.nonce, &t.to,
+                            &t.gas, &t.value, &t.input,
+                            &t.maxPriorityFeePerGas, &t.maxFeePerGas,
+                            &t.maxFeePerBlobGas, &t.gasPrice, &t.chainId,
+                            &t.yParity, &t.r, &t.s, &t.v}) +
+                 footprint(t.blobVersionedHashes);
+        for (const auto& a : t.accessList)
+            bytes += sizeof(a) + footprint(a.storageKeys);
+    }
+    for (const auto& w : b.withdrawals)
+        bytes += sizeof(w) +
+                 footprint({&w.index, &w.validatorIndex, &w.address,
+                            &w.amount});
+    return bytes;
+}
+
+}  // namespace
+
+BlockCache::BlockPtr BlockCache::getBlockByNumber(uint64_t number, bool full)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = chain_.find(number);
+    if (it != chain_.end())
+        if (BlockPtr block = lookup(entryKey(it->second.hash, full)))
+            return block;
+
+    return fetch("number:" + std::to_string(number) + (full ? "/full" : ""),
+                 full, true, lock,
+                 [&]() -> BlockPtr
+                 {
+                     auto block = rpc_.getBlockByNumber(number, full);
+                     if (!block)
+                         return nullptr;
+                     return std::make_shared<const Block>(std::move(*block));
+                 });
+}
+
+BlockCache::BlockPtr BlockCache::getBlockByHash(const std::string& hash,
+                                                bool full)
+{
+    std::string key = entryKey(hash, full);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (BlockPtr block = lookup(key))
+        return block;
+
+    return fetch("hash:" + key, full, false, lock,
+                 [&]() -> BlockPtr
+                 {
+                     auto block = rpc_.getBlockByHash(hash, full);
+                     if (!block)
+                         return nullptr;
+                     return std::make_shared<const Block>(std::move(*block));
+                 });
+}
+
+void BlockCache::invalidateFrom(uint64_t number)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    chain_.erase(chain_.lower_bound(number), chain_.end());
+    generation_++;
+}
+
+void BlockCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    chain_.clear();
+    stats_.bytes = 0;
+    generation_++;
+}
+
+BlockCacheStats BlockCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    BlockCacheStats stats = stats_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+BlockCache::BlockPtr BlockCache::fetch(const std::string& request, bool full,
+                                       bool byNumber,
+                                       std::unique_lock<std::mutex>& lock,
+                                       const std::function<BlockPtr()>& get)
+{
+    auto pending = inFlight_.find(request);
+    if (pending != inFlight_.end())
+    {
+        stats_.merged++;
+        std::shared_future<BlockPtr> result = pending->second;
+        lock.unlock();
+        return result.get();
+    }
+
+    stats_.misses++;
+    std::promise<BlockPtr> promise;
+    inFlight_.emplace(request, promise.get_future().share());
+    uint64_t generation = generation_;
+    lock.unlock();
+
+    BlockPtr block;
+    try
+    {
+        block = get();
+    }
+    catch (...)
+    {
+        lock.lock();
+        inFlight_.erase(request);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    inFlight_.erase(request);
+    if (block)
+    {
+        // Only blocks fetched by number are known to be canonical.
+        if (byNumber && generation == generation_)
+            link(*block);
+        insert(block, full);
+    }
+    lock.unlock();
+    promise.set_value(block);
+    return block;
+}
+
+BlockCache::BlockPtr BlockCache::lookup(const std::string& key)
+{
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+        return nullptr;
+    stats_.hits++;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.block;
+}
+
+void BlockCache::insert(BlockPtr block, bool full)
+{
+    std::string key = entryKey(block->hash, full);
+    size_t bytes = footprint(*block);
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+        stats_.bytes -= it->second.bytes;
+        it->second.block = std::move(block);
+        it->second.bytes = bytes;
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+    }
+    else
+    {
+        lru_.push_front(key);
+        entries_.emplace(std::move(key),
+                         Entry{std::move(block), full, bytes, lru_.begin()});
+    }
+    stats_.bytes += bytes;
+    evict();
+}
+
+void BlockCache::link(const Block& block)
+{
+    uint64_t number = type::compact::parseU64(block.number);
+    Link link{lower(block.hash), lower(block.parentHash)};
+
+    // The number now resolves elsewhere; whatever was above it is stale.
+    auto same = chain_.find(number);
+    if (same != chain_.end() && same->second.hash != link.hash)
+    {
+        stats_.reorgs++;
+        chain_.erase(same, chain_.end());
+    }
+
+    auto above = chain_.find(number + 1);
+    if (above != chain_.end() && above->second.parentHash != link.hash)
+    {
+        stats_.reorgs++;
+        chain_.erase(above, chain_.end());
+    }
+
+    // The parent was replaced. Lower numbers are checked in turn as they
+    // are fetched again.
+    auto below = number > 0 ? chain_.find(number - 1) : chain_.end();
+    if (below != chain_.end() && below->second.hash != link.parentHash)
+    {
+        stats_.reorgs++;
+        chain_.erase(below);
+    }
+
+    chain_[number] = std::move(link);
+}
+
+void BlockCache::evict()
+{
+    while (stats_.bytes > maxBytes_ && !lru_.empty())
+    {
+        auto it = entries_.find(lru_.back());
+        const Block& block = *it->second.block;
+        std::string hash = lower(block.hash);
+
+        // Keep resolving the number only while one of its variants is
+        // still cached.
+        if (!entries_.count(entryKey(hash, !it->second.full)))
+        {
+            auto link = chain_.find(type::compact::parseU64(block.number));
+            if (link != chain_.end() && link->second.hash == hash)
+                chain_.erase(link);
+        }
+
+        stats_.bytes -= it->second.bytes;
+        entries_.erase(it);
+        lru_.pop_back();
+    }
+}
+
+}  // namespace web3::eth
@@ -0,0 +1,153 @@
+#include "eth/contract.h"
+
+#include <utility>
+
+#include "utils/hex.h"
+
+namespace web3::eth
+{
+
+namespace
+{
+
+type::bytes decodeHex(const std::string& text)
+{
+    auto digits = utils::hex::stripPrefix(text);
+    type::bytes out(digits.size() / 2);
+    if (digits.size() % 2 ||
+        !utils::hex::decode(digits.data(), digits.size(), out.data()))
+        throw std::runtime_error("Invalid hex string: " + text);
+    return out;
+}
+
+type::address parseAddress(const std::string& text)
+{
+    return text.empty() ? type::address() : type::address(text);
+}
+
+type::uint256 parseQuantity(const std::string& text)
+{
+    return text.empty() ? type::uint256() : type::uint256(text);
+}
+
+}  // namespace
+
+ContractMethod::ContractMethod(std::shared_ptr<const abi::Interface> abi,
+                               const std::string& name, web3::eth::RPC& rpc)
+    : abi_{std::move(abi)}, name_{name}, rpc_{rpc}
+{
+    // Fail early on a name the ABI does not have.
+    if (name_.find('(') != std::string::npos)
+        abi_->function(name_);
+    else if (abi_->overloads(name_).empty())
+        throw std::out_of_range("ABI: no function " + name_);
+}
+
+ContractMethod& ContractMethod::param(const std::string& value)
+{
+    params_.emplace_back(value);
+    return *this;
+}
+
+ContractMethod& ContractMethod::param(uint64_t value)
+{
+    params_.emplace_back(value);
+    return *this;
+}
+
+ContractMethod& ContractMethod::param(bool value)
+{
+    params_.emplace_back(value);
+    return *this;
+}
+
+ContractMethod& ContractMethod::param(abi::Value value)
+{
+    params_.push_back(std::move(value));
+    return *this;
+}
+
+const abi::Function& ContractMethod::function() const
+{
+    return abi_->function(name_, params_.size());
+}
+
+type::bytes ContractMethod::encodeData() const
+{
+    return function().encodeCall(params_);
+}
+
+void ContractMethod::reset()
+{
+    params_.clear();
+}
+
+std::string ContractMethod::call(const std::string& to,
+                                 const std::string& from)
+{
+    type::request::Call message;
+    message.to = type::address(to);
+    message.from = parseAddress(from);
+    message.data = encodeData();
+    reset();
+    return rpc_.call(message);
+}
+
+abi::Value::Array ContractMethod::query(const std::string& to,
+                                       const std::string& from)
+{
+    const abi::Function& f = function();
+    type::bytes data = decodeHex(call(to, from));
+    return f.decodeOutput(data).toValue().toArray();
+}
+
+std::string ContractMethod::send(const std::string& from,
+                                 const std::string& to,
+                                 const std::string& value,
+                                 const std::string& gas)
+{
+    type::request::Call message;
+    message.to = type::address(to);
+    message.from = type::address(from);
+    message.data = encodeData();
+    message.value = parseQuantity(value);
+    message.gas = parseQuantity(gas);
+    reset();
+    return rpc_.sendTransaction(message);
+}
+
+Contract::Contract(const std::string& address, const nlohmann::json& abi,
+                   web3::eth::RPC& rpc)
+    : address_{address},
+      abi_{std::make_shared<const abi::Interface>(abi)},
+      rpc{rpc}
+{
+}
+
+ContractMethod Contract::method(const std::string& name)
+{
+    return ContractMethod(abi_, name, rpc);
+}
+
+std::string Contract::deploy(const nlohmann::json& abi,
+                             const std::string& bytecode,
+                             const std::string& from, web3::eth::RPC& rpc,
+                             const abi::Value::Array& args)
+{
+    abi::Interface compiled(abi);
+    type::bytes code = decodeHex(bytecode);
+    type::bytes encoded = abi::encode(compiled.constructor(), args);
+
+    type::request::Call message;
+    message.from = type::address(from);
+    message.data = std::move(code);
+    message.data.insert(message.data.end(), encoded.begin(), encoded.end());
+    return rpc.sendTransaction(message);
+}
+
+std::string Contract::address() const
+{
+    return address_;
+}
+
+}  // namespace web3::eth
@@ -3,7 +3,7 @@
 namespace web3::eth
 {
 
-Eth::Eth(RPC& rpc) : rpc_{rpc}, accounts_{}
+Eth::Eth(RPC& rpc) : rpc_{rpc}, accounts_{rpc}
 {
 }
 
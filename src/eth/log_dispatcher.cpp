@@ -0,0 +1,166 @@
+#include "eth/log_dispatcher.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "utils/hex.h"
+
+namespace web3::eth
+{
+
+namespace
+{
+
+bool decodeHex(std::string_view text, uint8_t* out, size_t size)
+{
+    auto digits = utils::hex::stripPrefix(text);
+    return digits.size() == 2 * size &&
+           utils::hex::decode(digits.data(), digits.size(), out);
+}
+
+}  // namespace
+
+void LogDispatcher::on(const type::address& contract, const abi::Event& event,
+                       Handler handler)
+{
+    if (event.anonymous)
+        throw std::invalid_argument("LogDispatcher: event " + event.name +
+                                    " is anonymous");
+
+    size_t topics = event.topicCount();
+
+    // The LogViews point at the event, so the route keeps its own copy.
+    auto copy = std::make_shared<const abi::Event>(event);
+    route(contract, event.topic0,
+          [copy, topics, handler = std::move(handler)](const abi::RawLog& log)
+          {
+              if (log.topics.size() != topics)
+                  return false;
+              handler(abi::LogView(*copy, log.topics.data(),
+                                   log.topics.size(), log.data.data(),
+                                   log.data.size()));
+              return true;
+          });
+}
+
+void LogDispatcher::on(const type::address& contract,
+                       const abi::Interface& abi, const std::string& event,
+                       Handler handler)
+{
+    on(contract, abi.event(event), std::move(handler));
+}
+
+size_t LogDispatcher::hash(const utils::Hash256& topic0,
+                           const type::address& address)
+{
+    // topic0 is a keccak256 and already uniform; the address is mixed in.
+    uint64_t t, a;
+    std::memcpy(&t, topic0.data(), 8);
+    std::memcpy(&a, address.bytes.data() + 12, 8);
+    return static_cast<size_t>(t ^ (a * 0x9e3779b97f4a7c15ull));
+}
+
+void LogDispatcher::route(const type::address& contract,
+                          const utils::Hash256& topic0, Route route)
+{
+    // Keep the table at most half full.
+    if (2 * (used_ + 1) > slots_.size())
+    {
+        std::vector<Slot> old = std::move(slots_);
+        slots_ = std::vector<Slot>(old.empty() ? 16 : 2 * old.size());
+        for (auto& slot : old)
+        {
+            if (!slot.used)
+                continue;
+            size_t mask = slots_.size() - 1;
+            size_t i = hash(slot.topic0, slot.address) & mask;
+            while (slots_[i].used)
+                i = (i + 1) & mask;
+            slots_[i] = std::move(slot);
+        }
+    }
+
+    size_t mask = slots_.size() - 1;
+    size_t i = hash(topic0, contract) & mask;
+    while (slots_[i].used &&
+           (slots_[i].topic0 != topic0 || slots_[i].address != contract))
+        i = (i + 1) & mask;
+
+    Slot& slot = slots_[i];
+    if (!slot.used)
+    {
+        slot.used = true;
+        slot.topic0 = topic0;
+        slot.address = contract;
+        used_++;
+    }
+    slot.routes.push_back(std::move(route));
+    routes_++;
+    wildcard_ = wildcard_ || contract == type::address();
+}
+
+const LogDispatcher::Slot* LogDispatcher::find(
+    const utils::Hash256& topic0, const type::address& address) const
+{
+    if (slots_.empty())
+        return nullptr;
+    size_t mask = slots_.size() - 1;
+    for (size_t i = hash(topic0, address) & mask; slots_[i].used;
+         i = (i + 1) & mask)
+        if (slots_[i].topic0 == topic0 && slots_[i].address == address)
+            return &slots_[i];
+    return nullptr;
+}
+
+size_t LogDispatcher::dispatch(const abi::RawLog& log) const
+{
+    if (log.topics.empty())
+        return 0;
+
+    size_t count = 0;
+    auto run = [&](const Slot* slot)
+    {
+        if (slot)
+            for (const auto& route : slot->routes)
+                count += route(log);
+    };
+    run(find(log.topics[0], log.address));
+    if (wildcard_ && log.address != type::address())
+        run(find(log.topics[0], type::address()));
+    return count;
+}
+
+size_t LogDispatcher::dispatch(const type::response::Log& log) const
+{
+    if (log.topics.empty() || slots_.empty())
+        return 0;
+
+    utils::Hash256 topic0;
+    type::address address;
+    if (!decodeHex(log.topics[0], topic0.data(), topic0.size()) ||
+        !decodeHex(log.address, address.bytes.data(), address.bytes.size()))
+        throw std::runtime_error("LogDispatcher: invalid log from " +
+                                 log.address);
+
+    if (!find(topic0, address) &&
+        !(wildcard_ && find(topic0, type::address())))
+        return 0;
+
+    // The rest of the log is only decoded once it has somewhere to go. The
+    // buffer is reused across logs to avoid reallocating.
+    thread_local abi::RawLog raw;
+    raw.assign(log);
+    return dispatch(raw);
+}
+
+size_t LogDispatcher::dispatch(
+    const std::vector<type::response::Log>& logs) const
+{
+    size_t count = 0;
+    for (const auto& log : logs)
+        count += dispatch(log);
+    return count;
+}
+
+}  // namespace web3::eth
@@ -0,0 +1,234 @@
+#include "eth/log_scanner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "core/error.h"
+
+namespace web3::eth
+{
+
+namespace
+{
+
+struct Range
+{
+    uint64_t from;
+    uint64_t to;
+    size_t attempts = 0;
+};
+
+struct Fetched
+{
+    uint64_t to;
+    std::vector<type::response::Log> logs;
+};
+
+}  // namespace
+
+bool LogScanner::isLimitError(const std::exception& error)
+{
+    auto rpcError = dynamic_cast<const rpc::JsonRPCException*>(&error);
+    if (rpcError && rpcError->Code() == rpc::Error::LIMITEXCEEDED)
+        return true;
+
+    // Providers differ in codes but agree on wording, e.g. "query returned
+    // more than 10000 results" or "block range is too large".
+    std::string message = error.what();
+    std::transform(message.begin(), message.end(), message.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (message.find("rate limit") != std::string::npos)
+        return false;
+    for (const char* text :
+         {"limit", "more than", "too many", "too large", "exceed"})
+        if (message.find(text) != std::string::npos)
+            return true;
+    return false;
+}
+
+uint64_t LogScanner::scan(const type::request::LogFilter& filter,
+                          uint64_t from, uint64_t to, const Handler& handler)
+{
+    if (from > to)
+        return 0;
+
+    const uint64_t minChunk = std::max<uint64_t>(options_.minChunk, 1);
+    const uint64_t maxChunk = std::max(options_.maxChunk, minChunk);
+    const size_t workers = std::max<size_t>(options_.workers, 1);
+    const size_t maxPending = std::max(options_.maxPending, workers);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    // Start of the next new range; exhausted once it passed to.
+    uint64_t next = from;
+    bool exhausted = false;
+    uint64_t chunk = std::clamp(options_.initialChunk, minChunk, maxChunk);
+    // Ranges to fetch again, keyed by first block; taken before new ones.
+    std::map<uint64_t, Range> retry;
+    // Fetched ranges waiting for the ones before them to be delivered.
+    std::map<uint64_t, Fetched> fetched;
+    size_t inFlight = 0;
+    bool stop = false;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e)
+    {
+        if (!error)
+            error = e;
+        stop = true;
+        cv.notify_all();
+    };
+
+    auto work = [&]
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cv.wait(lock,
+                    [&]
+                    {
+                        return stop || !retry.empty() ||
+                               (!exhausted &&
+                                inFlight + fetched.size() < maxPending) ||
+                               (exhausted && inFlight == 0);
+                    });
+            if (stop || (retry.empty() && exhausted))
+                return;
+
+            Range range;
+            if (!retry.empty())
+            {
+                // Retried ranges are cut to the current chunk size too.
+                range = retry.begin()->second;
+                retry.erase(retry.begin());
+                if (range.to - range.from >= chunk)
+                {
+                    Range rest{range.from + chunk, range.to, range.attempts};
+                    retry.emplace(rest.from, rest);
+                    range.to = range.from + chunk - 1;
+                }
+            }
+            else
+            {
+                uint64_t end = to - next < chunk - 1 ? to : next + chunk - 1;
+                range = {next, end};
+                exhausted = end == to;
+                next = end + 1;
+            }
+            inFlight++;
+            lock.unlock();
+
+            // Back off before retrying a range that failed outright.
+            if (range.attempts)
+                std::this_thread::sleep_for(
+                    std::chrono::milliseconds(100 * range.attempts));
+
+            type::request::LogFilter query = filter;
+            query.blockHash.clear();
+            query.fromBlock = type::uint256(range.from).toHex();
+            query.toBlock = type::uint256(range.to).toHex();
+
+            std::vector<type::response::Log> logs;
+            std::exception_ptr failure;
+            bool limited = false;
+            try
+            {
+                logs = rpc_.getLogs(query);
+            }
+            catch (const std::exception& e)
+            {
+                failure = std::current_exception();
+                limited = isLimitError(e);
+            }
+
+            lock.lock();
+            inFlight--;
+            uint64_t span = range.to - range.from + 1;
+            if (!failure)
+            {
+                // Steer towards targetLogs per request.
+                size_t count = logs.size();
+                if (count > options_.targetLogs)
+                    chunk = std::max(
+                        minChunk,
+                        std::min<uint64_t>(
+                            chunk, span * options_.targetLogs / count));
+                else if (2 * count < options_.targetLogs && span >= chunk)
+                    chunk = std::min(maxChunk, 2 * chunk);
+                fetched.emplace(range.from, Fetched{range.to, std::move(logs)});
+            }
+            else if (limited && span > minChunk)
+            {
+                // At most half the failed span from now on.
+                chunk = std::max(minChunk, std::min(chunk, span / 2));
+                retry.emplace(range.from, range);
+            }
+            else if (!limited && range.attempts < options_.retries)
+            {
+                range.attempts++;
+                retry.emplace(range.from, range);
+            }
+            else
+                fail(failure);
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workers; i++)
+        threads.emplace_back(work);
+
+    uint64_t total = 0;
+    uint64_t delivered = from;
+    try
+    {
+        for (;;)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock,
+                    [&]
+                    {
+                        return stop || (!fetched.empty() &&
+                                        fetched.begin()->first == delivered);
+                    });
+            if (stop)
+                break;
+            auto node = fetched.extract(fetched.begin());
+            lock.unlock();
+            // A slot under maxPending was freed.
+            cv.notify_all();
+
+            Fetched& range = node.mapped();
+            total += range.logs.size();
+            handler(range.logs, node.key(), range.to);
+            if (range.to == to)
+                break;
+            delivered = range.to + 1;
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        fail(std::current_exception());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        cv.notify_all();
+    }
+    for (auto& thread : threads)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+    return total;
+}
+
+}  // namespace web3::eth
@@ -0,0 +1,179 @@
+#include "eth/multicall.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "eth/abi.h"
+#include "utils.h"
+
+namespace web3::eth
+{
+
+namespace
+{
+
+// aggregate3((address,bool,bytes)[])
+constexpr uint8_t aggregate3[4] = {0x82, 0xad, 0x56, 0xcb};
+
+// Selector, offset of the array and its length.
+constexpr size_t headerSize = 4 + 32 + 32;
+
+size_t padded(size_t size)
+{
+    return (size + 31) / 32 * 32;
+}
+
+// Bytes one call adds to aggregate3 calldata: its offset in the array head,
+// then target, allowFailure, offset and length of the data, and the data.
+size_t callSize(size_t dataSize)
+{
+    return 32 + 4 * 32 + padded(dataSize);
+}
+
+// Out must be zeroed.
+void writeWord(uint8_t* out, uint64_t value)
+{
+    for (size_t i = 0; i < 8; i++)
+        out[31 - i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+}  // namespace
+
+Multicall::Multicall(RPC& rpc, MulticallLimits limits)
+    : Multicall(rpc, type::address(std::string(defaultAddress)), limits)
+{
+}
+
+Multicall::Multicall(RPC& rpc, const type::address& contract,
+                     MulticallLimits limits)
+    : rpc_{rpc}, contract_{contract}, limits_{limits}
+{
+}
+
+size_t Multicall::add(const type::address& target, type::bytes data,
+                      bool allowFailure, uint64_t gas)
+{
+    calls_.push_back({target, allowFailure, gas ? gas : limits_.callGas,
+                      std::move(data)});
+    return calls_.size() - 1;
+}
+
+size_t Multicall::add(const std::string& target, const ContractMethod& method,
+                      bool allowFailure, uint64_t gas)
+{
+    return add(type::address(target), method.encodeData(), allowFailure, gas);
+}
+
+std::vector<size_t> Multicall::chunks() const
+{
+    std::vector<size_t> starts;
+    size_t bytes = 0;
+    uint64_t gas = 0;
+    for (size_t i = 0; i < calls_.size(); i++)
+    {
+        size_t size = callSize(calls_[i].data.size());
+        // A call over the limits on its own still gets a chunk of its own.
+        if (starts.empty() || headerSize + bytes + size > limits_.calldata ||
+            gas + calls_[i].gas > limits_.gas)
+        {
+            starts.push_back(i);
+            bytes = 0;
+            gas = 0;
+        }
+        bytes += size;
+        gas += calls_[i].gas;
+    }
+    starts.push_back(calls_.size());
+    return starts;
+}
+
+type::bytes Multicall::encode(size_t begin, size_t end) const
+{
+    size_t count = end - begin;
+    size_t size = headerSize;
+    for (size_t i = begin; i < end; i++)
+        size += callSize(calls_[i].data.size());
+
+    type::bytes out(size);
+    std::memcpy(out.data(), aggregate3, 4);
+    writeWord(out.data() + 4, 32);
+    writeWord(out.data() + 36, count);
+
+    // Offsets in the array head count from the end of the length word.
+    uint8_t* array = out.data() + headerSize;
+    size_t tail = 32 * count;
+    for (size_t i = begin; i < end; i++)
+    {
+        const Pending& call = calls_[i];
+        writeWord(array + 32 * (i - begin), tail);
+
+        uint8_t* item = array + tail;
+        std::memcpy(item + 12, call.target.bytes.data(), 20);
+        item[63] = call.allowFailure;
+        writeWord(item + 64, 96);
+        writeWord(item + 96, call.data.size());
+        if (!call.data.empty())
+            std::memcpy(item + 128, call.data.data(), call.data.size());
+        tail += 4 * 32 + padded(call.data.size());
+    }
+    return out;
+}
+
+std::vector<type::bytes> Multicall::encode() const
+{
+    std::vector<type::bytes> out;
+    if (calls_.empty())
+        return out;
+    auto starts = chunks();
+    for (size_t c = 0; c + 1 < starts.size(); c++)
+        out.push_back(encode(starts[c], starts[c + 1]));
+    return out;
+}
+
+std::vector<Multicall::Result> Multicall::execute(const std::string& block)
+{
+    std::vector<Result> results(calls_.size());
+    if (calls_.empty())
+        return results;
+
+    auto starts = chunks();
+    std::vector<type::request::Call> messages(starts.size() - 1);
+    for (size_t c = 0; c < messages.size(); c++)
+    {
+        messages[c].to = contract_;
+        messages[c].data = encode(starts[c], starts[c + 1]);
+    }
+
+    std::vector<std::string> replies;
+    if (messages.size() == 1)
+        replies.push_back(rpc_.call(messages[0], block));
+    else
+        for (const auto& result : rpc_.callBatch(messages, block))
+            replies.push_back(result.get());
+    calls_.clear();
+
+    // returns ((bool success, bytes returnData)[])
+    static const abi::Type returns = abi::Type::parse("((bool,bytes)[])");
+    for (size_t c = 0; c < replies.size(); c++)
+    {
+        type::bytes data = utils::hexToBytes(replies[c]);
+        abi::View items = abi::View(returns, data.data(), data.size())[0];
+        size_t count = starts[c + 1] - starts[c];
+        if (items.length() != count)
+            throw std::runtime_error(
+                "Multicall: expected " + std::to_string(count) +
+                " results, got " + std::to_string(items.length()));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            abi::View item = items[i];
+            Result& result = results[starts[c] + i];
+            result.success = item[0].toBool();
+            auto payload = item[1].bytes();
+            result.data.assign(payload.begin(), payload.end());
+        }
+    }
+    return results;
+}
+
+}  // namespace web3::eth
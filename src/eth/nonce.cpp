@@ -0,0 +1,108 @@
+#include "eth/nonce.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "core/error.h"
+#include "eth/accounts.h"
+#include "utils.h"
+
+namespace web3::eth
+{
+
+uint64_t NonceManager::next(const Account& account)
+{
+    return reserve(account).value;
+}
+
+Nonce::Reservation NonceManager::reserve(const Account& account)
+{
+    Nonce& nonce = *account.nonce;
+    for (;;)
+    {
+        Nonce::Reservation taken = nonce.reserve();
+        if (taken.value != Nonce::unseeded)
+            return taken;
+
+        // One thread asks the node; the others wait for its answer.
+        std::lock_guard<std::mutex> lock(nonce.seeding_);
+        if (!nonce.seeded())
+            nonce.seed(type::uint256(rpc_.getTransactionCount(
+                                         {account.address, "pending"}))
+                           .toU64());
+    }
+}
+
+void NonceManager::resync(const Account& account)
+{
+    account.nonce->invalidate();
+}
+
+namespace
+{
+
+std::string lower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+// The node already has a transaction with this nonce, so it is behind.
+bool isNonceTooLow(const std::exception& error)
+{
+    std::string message = lower(error.what());
+    return message.find("nonce too low") != std::string::npos ||
+           message.find("nonce has already been used") != std::string::npos;
+}
+
+}  // namespace
+
+bool NonceManager::isNonceError(const std::exception& error)
+{
+    std::string message = lower(error.what());
+    for (const char* text : {"nonce too low", "nonce too high",
+                             "invalid nonce", "nonce has already been used"})
+        if (message.find(text) != std::string::npos)
+            return true;
+    return false;
+}
+
+std::string NonceManager::sendTransaction(const Account& account,
+                                          type::request::Transaction tx)
+{
+    for (bool retried = false;; retried = true)
+    {
+        Nonce::Reservation nonce = reserve(account);
+        tx.nonce = nonce.value;
+        std::string raw;
+        try
+        {
+            raw = utils::bytesToHex(
+                utils::sign::signTransaction(tx, account.secretKey));
+            return rpc_.sendRawTransaction(raw);
+        }
+        catch (const std::exception& e)
+        {
+            // Only the epoch the nonce came from is reset; a thread that
+            // already reseeded the counter has the newer count.
+            if (!retried && isNonceError(e))
+            {
+                account.nonce->invalidate(nonce, isNonceTooLow(e));
+                continue;
+            }
+            // An unused nonce left behind would stall every later send, but
+            // handing out one that is in flight would make two transactions
+            // share it. It is given back only when the transaction was never
+            // sent or the node answered that it refused it; after a
+            // transport failure it may have arrived, so the node is asked.
+            auto* reply = dynamic_cast<const rpc::JsonRPCException*>(&e);
+            bool unused = raw.empty() || (reply && reply->FromServer());
+            if (!unused || !account.nonce->release(nonce))
+                account.nonce->invalidate(nonce, false);
+            throw;
+        }
+    }
+}
+
+}  // namespace web3::eth
@@ -1,8 +1,153 @@
 #include "eth/rpc.h"
 
+#include "types/response_reader.h"
+
 namespace web3::eth
 {
 
+namespace
+{
+
+template <typename T>
+std::optional<T> readOptional(const std::string& raw)
+{
+    T out;
+    switch (type::response::read(raw, out))
+    {
+        case type::response::ReadStatus::Value:
+            return out;
+        case type::response::ReadStatus::Null:
+            return std::nullopt;
+        default:
+            rpc::JsonRPCClient::throwError(raw);
+    }
+}
+
+std::optional<type::response::LazyBlock> readLazy(std::string raw)
+{
+    type::response::LazyBlock block;
+    switch (block.load(std::move(raw)))
+    {
+        case type::response::ReadStatus::Value:
+            return block;
+        case type::response::ReadStatus::Null:
+            return std::nullopt;
+        default:
+            rpc::JsonRPCClient::throwError(block.text());
+    }
+}
+
+}  // namespace
+
+std::optional<type::response::Block> RPC::getBlockByNumber(uint64_t number,
+                                                           bool full)
+{
+    return readOptional<type::response::Block>(client_.callMethodRaw(
+        1, "eth_getBlockByNumber",
+        rpc::params(type::uint256(number).toHex(), full)));
+}
+
+std::optional<type::response::Block> RPC::getBlockByHash(
+    const std::string& hash, bool full)
+{
+    return readOptional<type::response::Block>(client_.callMethodRaw(
+        1, "eth_getBlockByHash", rpc::params(hash, full)));
+}
+
+std::optional<type::response::LazyBlock> RPC::getLazyBlockByNumber(
+    uint64_t number)
+{
+    return readLazy(client_.callMethodRaw(
+        1, "eth_getBlockByNumber",
+        rpc::params(type::uint256(number).toHex(), true)));
+}
+
+std::optional<type::response::LazyBlock> RPC::getLazyBlockByHash(
+    const std::string& hash)
+{
+    return readLazy(client_.callMethodRaw(
+        1, "eth_getBlockByHash", rpc::params(hash, true)));
+}
+
+std::optional<type::response::Transaction> RPC::getTransactionByHash(
+    const std::string& hash)
+{
+    return readOptional<type::response::Transaction>(client_.callMethodRaw(
+        1, "eth_getTransactionByHash", rpc::params(hash)));
+}
+
+std::optional<type::response::Receipt> RPC::getTransactionReceipt(
+    const std::string& hash)
+{
+    return readOptional<type::response::Receipt>(client_.callMethodRaw(
+        1, "eth_getTransactionReceipt", rpc::params(hash)));
+}
+
+std::vector<std::optional<type::response::Receipt>> RPC::getTransactionReceipts(
+    const std::vector<std::string>& hashes)
+{
+    using Receipt = std::optional<type::response::Receipt>;
+
+    auto batch = client_.batch();
+    std::vector<rpc::BatchResult<Receipt>> pending;
+    pending.reserve(hashes.size());
+    for (const auto& hash : hashes)
+        pending.push_back(batch.callMethod<Receipt>(
+            "eth_getTransactionReceipt", rpc::params(hash)));
+    batch.send();
+
+    std::vector<Receipt> receipts;
+    receipts.reserve(pending.size());
+    for (const auto& result : pending)
+        receipts.push_back(result.get());
+    return receipts;
+}
+
+std::string RPC::getTransactionCount(const type::request::Address& s)
+{
+    return client_.callMethod<std::string>(
+        1, "eth_getTransactionCount", rpc::params(s.address.toHex(), s.block));
+}
+
+std::string RPC::call(const type::request::Call& call,
+                      const std::string& block)
+{
+    return client_.callMethod<std::string>(1, "eth_call",
+                                           rpc::params(call, block));
+}
+
+std::vector<rpc::BatchResult<std::string>> RPC::callBatch(
+    const std::vector<type::request::Call>& calls, const std::string& block)
+{
+    auto batch = client_.batch();
+    std::vector<rpc::BatchResult<std::string>> pending;
+    pending.reserve(calls.size());
+    for (const auto& call : calls)
+        pending.push_back(batch.callMethod<std::string>(
+            "eth_call", rpc::params(call, block)));
+    batch.send();
+    return pending;
+}
+
+std::string RPC::sendTransaction(const type::request::Call& call)
+{
+    return client_.callMethod<std::string>(1, "eth_sendTransaction",
+                                           rpc::params(call));
+}
 
+std::vector<type::response::Log> RPC::getLogs(
+    const type::request::LogFilter& filter)
+{
+    // A null result is read as no logs.
+    auto logs = readOptional<std::vector<type::response::Log>>(
+        client_.callMethodRaw(1, "eth_getLogs", rpc::params(filter)));
+    return logs ? std::move(*logs) : std::vector<type::response::Log>();
+}
 
+std::string RPC::sendRawTransaction(const std::string& signedTx)
+{
+    return client_.callMethod<std::string>(1, "eth_sendRawTransaction",
+                                           rpc::params(signedTx));
 }
+
+}  // namespace web3::eth
@@ -0,0 +1,55 @@
+#include "eth/subscription.h"
+
+#include <nlohmann/json.hpp>
+
+#include "core/json_scan.h"
+
+namespace web3::eth
+{
+
+Subscriptions::Subscriptions(rpc::StreamConnector& connector)
+    : connector_{connector}
+{
+}
+
+std::string Subscriptions::newHeads(
+    std::function<void(const type::response::Block&)> handler)
+{
+    return connector_.subscribe(
+        R"(["newHeads"])",
+        [handler = std::move(handler)](std::string_view result)
+        {
+            handler(nlohmann::json::parse(result.begin(), result.end())
+                        .get<type::response::Block>());
+        });
+}
+
+std::string Subscriptions::logs(
+    const type::request::LogFilter& filter,
+    std::function<void(const type::response::Log&)> handler)
+{
+    nlohmann::json params = {"logs", filter};
+    return connector_.subscribe(
+        params.dump(),
+        [handler = std::move(handler)](std::string_view result)
+        {
+            handler(nlohmann::json::parse(result.begin(), result.end())
+                        .get<type::response::Log>());
+        });
+}
+
+std::string Subscriptions::newPendingTransactions(
+    std::function<void(const std::string& hash)> handler)
+{
+    return connector_.subscribe(
+        R"(["newPendingTransactions"])",
+        [handler = std::move(handler)](std::string_view result)
+        { handler(std::string(rpc::scan::unquote(result))); });
+}
+
+bool Subscriptions::unsubscribe(const std::string& subscriptionId)
+{
+    return connector_.unsubscribe(subscriptionId);
+}
+
+}  // namespace web3::eth
@@ -0,0 +1,241 @@
+#include "types/compact.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "utils/hex.h"
+
+namespace web3::type::compact
+{
+
+namespace
+{
+
+[[noreturn]] void invalid(std::string_view hex, const char* what)
+{
+    throw std::invalid_argument(std::string("compact: invalid ") + what +
+                                ": " + std::string(hex));
+}
+
+// Decodes a quantity right-aligned into size bytes, big-endian.
+void decodeQuantity(std::string_view hex, uint8_t* out, size_t size,
+                    const char* what)
+{
+    std::string_view digits = utils::hex::stripPrefix(hex);
+    if (digits.size() > 2 * size)
+        invalid(hex, what);
+
+    std::memset(out, 0, size);
+    uint8_t* dst = out + size - (digits.size() + 1) / 2;
+    if (digits.size() % 2)
+    {
+        const char pair[2] = {'0', digits[0]};
+        if (!utils::hex::decode(pair, 2, dst++))
+            invalid(hex, what);
+        digits.remove_prefix(1);
+    }
+    if (!utils::hex::decode(digits.data(), digits.size(), dst))
+        invalid(hex, what);
+}
+
+template <size_t N>
+void decodeFixed(std::string_view hex, uint8_t* out, const char* what)
+{
+    std::string_view digits = utils::hex::stripPrefix(hex);
+    if (digits.empty())
+    {
+        std::memset(out, 0, N);
+        return;
+    }
+    if (digits.size() != 2 * N ||
+        !utils::hex::decode(digits.data(), digits.size(), out))
+        invalid(hex, what);
+}
+
+std::optional<address> parseOptionalAddress(std::string_view hex)
+{
+    if (utils::hex::stripPrefix(hex).empty())
+        return std::nullopt;
+    return parseAddress(hex);
+}
+
+std::vector<Hash> parseHashes(const std::vector<std::string>& hexes)
+{
+    std::vector<Hash> out;
+    out.reserve(hexes.size());
+    for (const auto& hex : hexes)
+        out.push_back(parseHash(hex));
+    return out;
+}
+
+template <typename T, typename R>
+std::vector<T> convertAll(const std::vector<R>& items)
+{
+    std::vector<T> out;
+    out.reserve(items.size());
+    for (const auto& item : items)
+        out.push_back(fromResponse(item));
+    return out;
+}
+
+}  // namespace
+
+uint64_t parseU64(std::string_view hex)
+{
+    uint8_t buf[8];
+    decodeQuantity(hex, buf, sizeof(buf), "quantity");
+    uint64_t value = 0;
+    for (uint8_t b : buf)
+        value = value << 8 | b;
+    return value;
+}
+
+uint256 parseU256(std::string_view hex)
+{
+    uint8_t buf[32];
+    decodeQuantity(hex, buf, sizeof(buf), "quantity");
+    return uint256::fromBytes(buf, sizeof(buf));
+}
+
+Hash parseHash(std::string_view hex)
+{
+    Hash out;
+    decodeFixed<32>(hex, out.data(), "hash");
+    return out;
+}
+
+Bloom parseBloom(std::string_view hex)
+{
+    Bloom out;
+    decodeFixed<256>(hex, out.data(), "bloom");
+    return out;
+}
+
+address parseAddress(std::string_view hex)
+{
+    address out;
+    decodeFixed<20>(hex, out.bytes.data(), "address");
+    return out;
+}
+
+bytes parseBytes(std::string_view hex)
+{
+    std::string_view digits = utils::hex::stripPrefix(hex);
+    bytes out(digits.size() / 2);
+    if (digits.size() % 2 ||
+        !utils::hex::decode(digits.data(), digits.size(), out.data()))
+        invalid(hex, "data");
+    return out;
+}
+
+AccessList fromResponse(const response::AccessList& a)
+{
+    return {a.address, parseHashes(a.storageKeys)};
+}
+
+Transaction fromResponse(const response::Transaction& t)
+{
+    Transaction out;
+    out.blockHash = parseHash(t.blockHash);
+    out.blockNumber = parseU64(t.blockNumber);
+    out.from = parseAddress(t.from);
+    out.transactionIndex = parseU64(t.transactionIndex);
+    out.type = static_cast<uint8_t>(parseU64(t.type));
+    out.nonce = parseU64(t.nonce);
+    out.to = parseOptionalAddress(t.to);
+    out.gas = parseU64(t.gas);
+    out.value = parseU256(t.value);
+    out.input = parseBytes(t.input);
+    out.maxPriorityFeePerGas = parseU256(t.maxPriorityFeePerGas);
+    out.maxFeePerGas = parseU256(t.maxFeePerGas);
+    out.maxFeePerBlobGas = parseU256(t.maxFeePerBlobGas);
+    out.gasPrice = parseU256(t.gasPrice);
+    out.accessList = convertAll<AccessList>(t.accessList);
+    out.blobVersionedHashes = parseHashes(t.blobVersionedHashes);
+    out.chainId = parseU64(t.chainId);
+    out.yParity = static_cast<uint8_t>(parseU64(t.yParity));
+    out.r = parseU256(t.r);
+    out.s = parseU256(t.s);
+    out.v = parseU64(t.v);
+    return out;
+}
+
+Withdrawal fromResponse(const response::Withdrawal& w)
+{
+    Withdrawal out;
+    out.index = parseU64(w.index);
+    out.validatorIndex = parseU64(w.validatorIndex);
+    out.address = parseAddress(w.address);
+    out.amount = parseU64(w.amount);
+    return out;
+}
+
+Block fromResponse(const response::Block& b)
+{
+    Block out;
+    out.hash = parseHash(b.hash);
+    out.parentHash = parseHash(b.parentHash);
+    out.sha3Uncles = parseHash(b.sha3Uncles);
+    out.miner = parseAddress(b.miner);
+    out.stateRoot = parseHash(b.stateRoot);
+    out.transactionsRoot = parseHash(b.transactionsRoot);
+    out.receiptsRoot = parseHash(b.receiptsRoot);
+    out.logsBloom = parseBloom(b.logsBloom);
+    out.difficulty = parseU256(b.difficulty);
+    out.number = parseU64(b.number);
+    out.gasLimit = parseU64(b.gasLimit);
+    out.gasUsed = parseU64(b.gasUsed);
+    out.timestamp = parseU64(b.timestamp);
+    out.extraData = parseBytes(b.extraData);
+    out.mixHash = parseHash(b.mixHash);
+    out.nonce = parseU64(b.nonce);
+    out.baseFeePerGas = parseU256(b.baseFeePerGas);
+    out.withdrawalsRoot = parseHash(b.withdrawalsRoot);
+    out.size = parseU64(b.size);
+    out.transactions = convertAll<Transaction>(b.transactions);
+    out.transactionHashes = parseHashes(b.transactionHashes);
+    out.withdrawals = convertAll<Withdrawal>(b.withdrawals);
+    out.uncles = parseHashes(b.uncles);
+    return out;
+}
+
+Log fromResponse(const response::Log& l)
+{
+    Log out;
+    out.removed = l.removed;
+    out.logIndex = parseU64(l.logIndex);
+    out.transactionIndex = parseU64(l.transactionIndex);
+    out.transactionHash = parseHash(l.transactionHash);
+    out.blockHash = parseHash(l.blockHash);
+    out.blockNumber = parseU64(l.blockNumber);
+    out.blockTimestamp = parseU64(l.blockTimestamp);
+    out.address = parseAddress(l.address);
+    out.data = parseBytes(l.data);
+    out.topics = parseHashes(l.topics);
+    return out;
+}
+
+Receipt fromResponse(const response::Receipt& r)
+{
+    Receipt out;
+    out.type = static_cast<uint8_t>(parseU64(r.type));
+    out.transactionHash = parseHash(r.transactionHash);
+    out.transactionIndex = parseU64(r.transactionIndex);
+    out.blockHash = parseHash(r.blockHash);
+    out.blockNumber = parseU64(r.blockNumber);
+    out.from = parseAddress(r.from);
+    out.to = parseOptionalAddress(r.to);
+    out.cumulativeGasUsed = parseU64(r.cumulativeGasUsed);
+    out.gasUsed = parseU64(r.gasUsed);
+    out.blobGasUsed = parseU64(r.blobGasUsed);
+    out.contractAddress = parseOptionalAddress(r.contractAddress);
+    out.logsBloom = parseBloom(r.logsBloom);
+    out.root = parseHash(r.root);
+    out.status = static_cast<uint8_t>(parseU64(r.status));
+    out.effectiveGasPrice = parseU256(r.effectiveGasPrice);
+    out.blobGasPrice = parseU256(r.blobGasPrice);
+    return out;
+}
+
+}  // namespace web3::type::compact
@@ -0,0 +1,235 @@
+#include "types/lazy_block.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "core/json_scan.h"
+
+namespace web3::type::response
+{
+
+namespace scan = web3::rpc::scan;
+
+namespace
+{
+
+// Like scan::forEachMember, but f(key, valueBegin) returns the end of the
+// value, so a value the caller walks itself is only scanned once. Returns
+// false if the object is malformed or f returns npos.
+template <typename F>
+bool walkObject(std::string_view text, size_t pos, F&& f)
+{
+    pos = scan::skipSpace(text, pos);
+    if (pos >= text.size() || text[pos] != '{')
+        return false;
+    pos = scan::skipSpace(text, pos + 1);
+    if (pos < text.size() && text[pos] == '}')
+        return true;
+
+    while (pos < text.size())
+    {
+        if (text[pos] != '"')
+            return false;
+        size_t keyEnd = scan::stringEnd(text, pos);
+        if (keyEnd == scan::npos)
+            return false;
+        std::string_view key = text.substr(pos + 1, keyEnd - pos - 2);
+
+        pos = scan::skipSpace(text, keyEnd);
+        if (pos >= text.size() || text[pos] != ':')
+            return false;
+        size_t end = f(key, scan::skipSpace(text, pos + 1));
+        if (end == scan::npos)
+            return false;
+
+        pos = scan::skipSpace(text, end);
+        if (pos >= text.size())
+            return false;
+        if (text[pos] == '}')
+            return true;
+        if (text[pos] != ',')
+            return false;
+        pos = scan::skipSpace(text, pos + 1);
+    }
+    return false;
+}
+
+std::string_view valueOf(std::string_view raw)
+{
+    return raw == "null" ? std::string_view() : scan::unquote(raw);
+}
+
+}  // namespace
+
+ReadStatus LazyBlock::load(std::string response)
+{
+    text_ = std::move(response);
+    fields_.clear();
+    transactions_.clear();
+    decoded_.clear();
+    full_ = false;
+
+    std::string_view text(text_);
+    ReadStatus status = ReadStatus::Error;
+
+    auto readResult = [&](size_t begin)
+    {
+        if (text.compare(begin, 4, "null") == 0)
+        {
+            status = ReadStatus::Null;
+            return scan::valueEnd(text, begin);
+        }
+
+        size_t end = begin;
+        bool ok = walkObject(
+            text, begin,
+            [&](std::string_view key, size_t pos)
+            {
+                if (key != "transactions")
+                {
+                    end = scan::valueEnd(text, pos);
+                    size_t k = key.data() - text.data();
+                    fields_.push_back({{k, k + key.size()}, {pos, end}});
+                    return end;
+                }
+
+                // Index the transactions while finding the array's end.
+                size_t last = pos;
+                bool listed = scan::forEachElement(
+                    text, pos,
+                    [&](size_t first, size_t next)
+                    {
+                        transactions_.push_back({first, next});
+                        last = next;
+                        return true;
+                    });
+                size_t close = listed ? text.find(']', last) : scan::npos;
+                end = close == scan::npos ? close : close + 1;
+                return end;
+            });
+        if (!ok)
+            return scan::npos;
+
+        status = ReadStatus::Value;
+        // Past the closing brace of the result.
+        return text.find('}', end) + 1;
+    };
+
+    bool ok = walkObject(text, 0,
+                         [&](std::string_view key, size_t pos)
+                         {
+                             if (key == "error")
+                                 return scan::npos;
+                             if (key == "result")
+                                 return readResult(pos);
+                             return scan::valueEnd(text, pos);
+                         });
+    if (!ok)
+        return ReadStatus::Error;
+
+    if (status == ReadStatus::Value)
+    {
+        full_ = !transactions_.empty() &&
+                text[transactions_.front().begin] == '{';
+        decoded_.resize(full_ ? transactions_.size() : 0);
+    }
+    return status;
+}
+
+std::string_view LazyBlock::field(std::string_view name) const
+{
+    for (const auto& f : fields_)
+        if (view(f.key) == name)
+            return valueOf(view(f.value));
+    return {};
+}
+
+compact::Block LazyBlock::header() const
+{
+    compact::Block b;
+    b.hash = compact::parseHash(field("hash"));
+    b.parentHash = compact::parseHash(field("parentHash"));
+    b.sha3Uncles = compact::parseHash(field("sha3Uncles"));
+    b.miner = compact::parseAddress(field("miner"));
+    b.stateRoot = compact::parseHash(field("stateRoot"));
+    b.transactionsRoot = compact::parseHash(field("transactionsRoot"));
+    b.receiptsRoot = compact::parseHash(field("receiptsRoot"));
+    b.logsBloom = compact::parseBloom(field("logsBloom"));
+    b.difficulty = compact::parseU256(field("difficulty"));
+    b.number = compact::parseU64(field("number"));
+    b.gasLimit = compact::parseU64(field("gasLimit"));
+    b.gasUsed = compact::parseU64(field("gasUsed"));
+    b.timestamp = compact::parseU64(field("timestamp"));
+    b.extraData = compact::parseBytes(field("extraData"));
+    b.mixHash = compact::parseHash(field("mixHash"));
+    b.nonce = compact::parseU64(field("nonce"));
+    b.baseFeePerGas = compact::parseU256(field("baseFeePerGas"));
+    b.withdrawalsRoot = compact::parseHash(field("withdrawalsRoot"));
+    b.size = compact::parseU64(field("size"));
+
+    if (!full_)
+        for (size_t i = 0; i < transactions_.size(); i++)
+            b.transactionHashes.push_back(transactionHash(i));
+
+    std::string_view uncles = field("uncles");
+    scan::forEachElement(uncles, 0,
+                         [&](size_t begin, size_t end)
+                         {
+                             b.uncles.push_back(compact::parseHash(
+                                 valueOf(uncles.substr(begin, end - begin))));
+                             return true;
+                         });
+
+    std::string_view withdrawals = field("withdrawals");
+    scan::forEachElement(
+        withdrawals, 0,
+        [&](size_t begin, size_t end)
+        {
+            auto item = withdrawals.substr(begin, end - begin);
+            auto get = [&](std::string_view key)
+            { return valueOf(scan::member(item, key)); };
+            b.withdrawals.push_back(
+                {compact::parseU64(get("index")),
+                 compact::parseU64(get("validatorIndex")),
+                 compact::parseAddress(get("address")),
+                 compact::parseU64(get("amount"))});
+            return true;
+        });
+    return b;
+}
+
+std::string_view LazyBlock::transactionText(size_t i) const
+{
+    return view(transactions_.at(i));
+}
+
+const compact::Transaction& LazyBlock::transaction(size_t i) const
+{
+    std::string_view text = transactionText(i);
+    if (!full_)
+        throw std::runtime_error(
+            "LazyBlock: block was fetched without full transactions");
+
+    auto& slot = decoded_[i];
+    if (!slot)
+    {
+        Transaction tx;
+        if (readValue(text, tx) != ReadStatus::Value)
+            throw std::runtime_error("LazyBlock: malformed transaction " +
+                                     std::to_string(i));
+        slot = std::make_unique<compact::Transaction>(
+            compact::fromResponse(tx));
+    }
+    return *slot;
+}
+
+compact::Hash LazyBlock::transactionHash(size_t i) const
+{
+    std::string_view text = transactionText(i);
+    if (full_)
+        throw std::runtime_error(
+            "LazyBlock: block was fetched with full transactions");
+    return compact::parseHash(valueOf(text));
+}
+
+}  // namespace web3::type::response
@@ -1,41 +1,107 @@
 #include "types/native.h"
 
+#include <stdexcept>
+
 #include "utils.h"
+#include "utils/hex.h"
+#include "utils/keccak.h"
 
 namespace web3::type
 {
 
+uint256 uint256::fromBytes(const uint8_t* data, size_t size)
+{
+    uint256 r;
+    // Leading zero bytes beyond the 32 significant ones are tolerated.
+    for (; size > 32; data++, size--)
+        if (*data)
+            throw std::out_of_range("uint256: more than 32 bytes");
+    for (size_t i = 0; i < size; i++)
+    {
+        size_t bit = (size - 1 - i) * 8;
+        r.limbs[bit / 64] |= static_cast<uint64_t>(data[i]) << (bit % 64);
+    }
+    return r;
+}
+
+std::array<uint8_t, 32> uint256::toBytes() const
+{
+    std::array<uint8_t, 32> out;
+    for (size_t i = 0; i < 32; i++)
+    {
+        size_t bit = (31 - i) * 8;
+        out[i] = static_cast<uint8_t>(limbs[bit / 64] >> (bit % 64));
+    }
+    return out;
+}
+
+std::string uint256::toHex() const
+{
+    static const char digits[] = "0123456789abcdef";
+    if (isZero())
+        return "0x0";
+
+    size_t nibbles = (bitLength() + 3) / 4;
+    std::string out(2 + nibbles, '0');
+    out[1] = 'x';
+    for (size_t i = 0; i < nibbles; i++)
+        out[out.size() - 1 - i] = digits[(limbs[i / 16] >> (i % 16 * 4)) & 0xf];
+    return out;
+}
+
+std::string uint256::toDec() const
+{
+    if (isZero())
+        return "0";
+
+    // Peel off 19 decimal digits per division.
+    constexpr uint64_t chunk = 10000000000000000000ULL;
+    uint256 n = *this;
+    char buf[80];
+    size_t pos = sizeof(buf);
+    while (!n.isZero())
+    {
+        uint64_t rem = n.divSmall(chunk);
+        bool last = n.isZero();
+        for (int i = 0; i < 19 && (!last || rem); i++)
+        {
+            buf[--pos] = static_cast<char>('0' + rem % 10);
+            rem /= 10;
+        }
+    }
+    return std::string(buf + pos, sizeof(buf) - pos);
+}
+
 address::address(const std::string& hex)
 {
-    auto b = utils::hexToBytes(hex);
-    if (b.size() != 20)
+    auto digits = utils::hex::stripPrefix(hex);
+    if (digits.size() != 40)
         throw std::runtime_error("Invalid address length");
-    std::copy(b.begin(), b.end(), bytes.begin());
+    if (!utils::hex::decode(digits.data(), digits.size(), bytes.data()))
+        throw std::runtime_error("Invalid address: " + hex);
 }
 
 std::string address::toHex() const
 {
-    return utils::bytesToHex(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+    std::string out(42, '0');
+    out[1] = 'x';
+    utils::hex::encode(bytes.data(), bytes.size(), &out[2]);
+    return out;
 }
 
 std::string address::toChecksumAddress() const
 {
-    std::string addr = web3::utils::removeHexPrefix(toHex());
+    // EIP-55: uppercase each letter whose nibble in the hash of the
+    // lowercase hex address is 8 or more.
+    std::string out = toHex();
+    auto hash = utils::Keccak256::hash(std::string_view(out).substr(2));
 
-    auto hashHex = web3::utils::keccak256(
-        std::vector<uint8_t>(bytes.begin(), bytes.end()));
-
-    for (size_t i = 0; i < addr.size(); i++)
+    for (size_t i = 0; i < 40; i++)
     {
-        uint8_t hval = (hashHex[i] >= '0' && hashHex[i] <= '9')
-                           ? hashHex[i] - '0'
-                           : (tolower(hashHex[i]) - 'a' + 10);
-        if (hval >= 8)
-            addr[i] = toupper(addr[i]);
-        else
-            addr[i] = tolower(addr[i]);
+        uint8_t nibble = (hash[i / 2] >> (i % 2 ? 0 : 4)) & 0xf;
+        if (nibble >= 8)
+            out[i + 2] = toupper(out[i + 2]);
     }
-
-    return web3::utils::ensureHexPrefix(addr);
+    return out;
 }
 }  // namespace web3::type
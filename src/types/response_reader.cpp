@@ -0,0 +1,453 @@
+#include "types/response_reader.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace web3::type::response
+{
+
+namespace
+{
+
+template <typename T>
+using Fields = std::unordered_map<std::string_view, std::string T::*>;
+
+const Fields<Block> blockFields = {
+    {"hash", &Block::hash},
+    {"parentHash", &Block::parentHash},
+    {"sha3Uncles", &Block::sha3Uncles},
+    {"miner", &Block::miner},
+    {"stateRoot", &Block::stateRoot},
+    {"transactionsRoot", &Block::transactionsRoot},
+    {"receiptsRoot", &Block::receiptsRoot},
+    {"logsBloom", &Block::logsBloom},
+    {"difficulty", &Block::difficulty},
+    {"number", &Block::number},
+    {"gasLimit", &Block::gasLimit},
+    {"gasUsed", &Block::gasUsed},
+    {"timestamp", &Block::timestamp},
+    {"extraData", &Block::extraData},
+    {"mixHash", &Block::mixHash},
+    {"nonce", &Block::nonce},
+    {"baseFeePerGas", &Block::baseFeePerGas},
+    {"withdrawalsRoot", &Block::withdrawalsRoot},
+    {"size", &Block::size},
+};
+
+const Fields<Transaction> transactionFields = {
+    {"blockHash", &Transaction::blockHash},
+    {"blockNumber", &Transaction::blockNumber},
+    {"from", &Transaction::from},
+    {"transactionIndex", &Transaction::transactionIndex},
+    {"type", &Transaction::type},
+    {"nonce", &Transaction::nonce},
+    {"to", &Transaction::to},
+    {"gas", &Transaction::gas},
+    {"value", &Transaction::value},
+    {"input", &Transaction::input},
+    {"maxPriorityFeePerGas", &Transaction::maxPriorityFeePerGas},
+    {"maxFeePerGas", &Transaction::maxFeePerGas},
+    {"maxFeePerBlobGas", &Transaction::maxFeePerBlobGas},
+    {"gasPrice", &Transaction::gasPrice},
+    {"chainId", &Transaction::chainId},
+    {"yParity", &Transaction::yParity},
+    {"r", &Transaction::r},
+    {"s", &Transaction::s},
+    {"v", &Transaction::v},
+};
+
+const Fields<Withdrawal> withdrawalFields = {
+    {"index", &Withdrawal::index},
+    {"validatorIndex", &Withdrawal::validatorIndex},
+    {"address", &Withdrawal::address},
+    {"amount", &Withdrawal::amount},
+};
+
+const Fields<Log> logFields = {
+    {"logIndex", &Log::logIndex},
+    {"transactionIndex", &Log::transactionIndex},
+    {"transactionHash", &Log::transactionHash},
+    {"blockHash", &Log::blockHash},
+    {"blockNumber", &Log::blockNumber},
+    {"blockTimestamp", &Log::blockTimestamp},
+    {"address", &Log::address},
+    {"data", &Log::data},
+};
+
+const Fields<Receipt> receiptFields = {
+    {"type", &Receipt::type},
+    {"transactionHash", &Receipt::transactionHash},
+    {"transactionIndex", &Receipt::transactionIndex},
+    {"blockHash", &Receipt::blockHash},
+    {"blockNumber", &Receipt::blockNumber},
+    {"from", &Receipt::from},
+    {"to", &Receipt::to},
+    {"cumulativeGasUsed", &Receipt::cumulativeGasUsed},
+    {"gasUsed", &Receipt::gasUsed},
+    {"blobGasUsed", &Receipt::blobGasUsed},
+    {"contractAddress", &Receipt::contractAddress},
+    {"logsBloom", &Receipt::logsBloom},
+    {"root", &Receipt::root},
+    {"status", &Receipt::status},
+    {"effectiveGasPrice", &Receipt::effectiveGasPrice},
+    {"blobGasPrice", &Receipt::blobGasPrice},
+};
+
+template <typename T>
+std::string* field(void* target, const Fields<T>& fields,
+                   const std::string& key)
+{
+    auto it = fields.find(key);
+    return it == fields.end() ? nullptr
+                              : &(static_cast<T*>(target)->*(it->second));
+}
+
+/**
+ * @brief SAX handler filling the response types as the parser walks the
+ * text.
+ *
+ * A stack holds what each open object or array fills in. Values nothing
+ * wants are skipped by counting their nesting depth.
+ */
+class Reader
+{
+   public:
+    enum class Kind : uint8_t
+    {
+        Envelope,
+        Block,
+        Transaction,
+        AccessList,
+        Withdrawal,
+        Log,
+        Receipt,
+        // Arrays.
+        Strings,
+        Transactions,
+        AccessLists,
+        Withdrawals,
+        Logs,
+        Receipts
+    };
+
+    // A bare reader reads the value itself rather than a response
+    // envelope around it.
+    Reader(Kind kind, void* root, bool bare)
+        : rootKind_(kind), root_(root), bare_(bare)
+    {
+        stack_.reserve(8);
+    }
+
+    ReadStatus status() const
+    {
+        return status_;
+    }
+
+    bool null()
+    {
+        if (!skip_ && (bare_ ? stack_.empty()
+                             : stack_.size() == 1 && key_ == "result"))
+            status_ = ReadStatus::Null;
+        return true;
+    }
+
+    bool boolean(bool value)
+    {
+        if (stack_.empty())
+            return false;
+        if (!skip_ && stack_.back().kind == Kind::Log && key_ == "removed")
+            static_cast<Log*>(stack_.back().target)->removed = value;
+        return true;
+    }
+
+    bool number_integer(int64_t)
+    {
+        return true;
+    }
+
+    bool number_unsigned(uint64_t)
+    {
+        return true;
+    }
+
+    bool number_float(double, const std::string&)
+    {
+        return true;
+    }
+
+    bool binary(nlohmann::json::binary_t&)
+    {
+        return true;
+    }
+
+    bool string(std::string& value);
+
+    bool key(std::string& key)
+    {
+        if (!skip_)
+            key_.assign(key);
+        return true;
+    }
+
+    bool start_object(size_t);
+    bool start_array(size_t);
+
+    bool end_object()
+    {
+        return end();
+    }
+
+    bool end_array()
+    {
+        return end();
+    }
+
+    bool parse_error(size_t, const std::string&,
+                     const nlohmann::detail::exception&)
+    {
+        status_ = ReadStatus::Error;
+        return false;
+    }
+
+   private:
+    struct Level
+    {
+        Kind kind;
+        void* target;
+    };
+
+    bool end()
+    {
+        if (skip_)
+            skip_--;
+        else
+            stack_.pop_back();
+        return true;
+    }
+
+    bool push(Kind kind, void* target)
+    {
+        stack_.push_back({kind, target});
+        return true;
+    }
+
+    bool skip()
+    {
+        skip_ = 1;
+        return true;
+    }
+
+    // The result member of the envelope.
+    bool result(bool array);
+
+    Kind rootKind_;
+    void* root_;
+    bool bare_;
+    ReadStatus status_ = ReadStatus::Error;
+    std::vector<Level> stack_;
+    // Depth inside a value that is being skipped.
+    size_t skip_ = 0;
+    std::string key_;
+};
+
+bool Reader::string(std::string& value)
+{
+    if (skip_)
+        return true;
+    // A bare value of the wrong shape.
+    if (stack_.empty())
+        return false;
+
+    const Level& top = stack_.back();
+    std::string* target = nullptr;
+    switch (top.kind)
+    {
+        case Kind::Envelope:
+            // A result of the wrong shape; the DOM path reports it.
+            return key_ != "result";
+        case Kind::Block:
+            target = field(top.target, blockFields, key_);
+            break;
+        case Kind::Transaction:
+            target = field(top.target, transactionFields, key_);
+            break;
+        case Kind::AccessList:
+            if (key_ == "address")
+                static_cast<AccessList*>(top.target)->address =
+                    type::address(value);
+            break;
+        case Kind::Withdrawal:
+            target = field(top.target, withdrawalFields, key_);
+            break;
+        case Kind::Log:
+            target = field(top.target, logFields, key_);
+            break;
+        case Kind::Receipt:
+            target = field(top.target, receiptFields, key_);
+            break;
+        case Kind::Strings:
+            static_cast<std::vector<std::string>*>(top.target)
+                ->push_back(std::move(value));
+            break;
+        case Kind::Transactions:
+            // Blocks fetched without full transactions list their hashes.
+            static_cast<Block*>(top.target)
+                ->transactionHashes.push_back(std::move(value));
+            break;
+        case Kind::Logs:
+            // Filter changes of block and pending transaction filters.
+            static_cast<std::vector<Log>*>(top.target)
+                ->emplace_back()
+                .transactionHash = std::move(value);
+            break;
+        default:
+            break;
+    }
+    if (target)
+        *target = std::move(value);
+    return true;
+}
+
+bool Reader::result(bool array)
+{
+    bool isArray = rootKind_ == Kind::Logs || rootKind_ == Kind::Receipts;
+    if (array != isArray)
+        return false;
+    status_ = ReadStatus::Value;
+    return push(rootKind_, root_);
+}
+
+bool Reader::start_object(size_t)
+{
+    if (skip_)
+    {
+        skip_++;
+        return true;
+    }
+    if (stack_.empty())
+        return bare_ ? result(false) : push(Kind::Envelope, nullptr);
+
+    const Level& top = stack_.back();
+    switch (top.kind)
+    {
+        case Kind::Envelope:
+            if (key_ == "result")
+                return result(false);
+            // The error is read by re-parsing the whole response.
+            return key_ == "error" ? false : skip();
+        case Kind::Transactions:
+            return push(Kind::Transaction, &static_cast<Block*>(top.target)
+                                                ->transactions.emplace_back());
+        case Kind::AccessLists:
+            return push(Kind::AccessList,
+                        &static_cast<std::vector<AccessList>*>(top.target)
+                             ->emplace_back());
+        case Kind::Withdrawals:
+            return push(Kind::Withdrawal,
+                        &static_cast<std::vector<Withdrawal>*>(top.target)
+                             ->emplace_back());
+        case Kind::Logs:
+            return push(Kind::Log, &static_cast<std::vector<Log>*>(top.target)
+                                        ->emplace_back());
+        case Kind::Receipts:
+            return push(Kind::Receipt,
+                        &static_cast<std::vector<Receipt>*>(top.target)
+                             ->emplace_back());
+        default:
+            return skip();
+    }
+}
+
+bool Reader::start_array(size_t)
+{
+    if (skip_)
+    {
+        skip_++;
+        return true;
+    }
+    // A batch response; only single responses are read here.
+    if (stack_.empty())
+        return bare_ && result(true);
+
+    const Level& top = stack_.back();
+    switch (top.kind)
+    {
+        case Kind::Envelope:
+            return key_ == "result" ? result(true) : skip();
+        case Kind::Block:
+        {
+            auto* block = static_cast<Block*>(top.target);
+            if (key_ == "transactions")
+                return push(Kind::Transactions, block);
+            if (key_ == "withdrawals")
+                return push(Kind::Withdrawals, &block->withdrawals);
+            if (key_ == "uncles")
+                return push(Kind::Strings, &block->uncles);
+            return skip();
+        }
+        case Kind::Transaction:
+        {
+            auto* tx = static_cast<Transaction*>(top.target);
+            if (key_ == "accessList")
+                return push(Kind::AccessLists, &tx->accessList);
+            if (key_ == "blobVersionedHashes")
+                return push(Kind::Strings, &tx->blobVersionedHashes);
+            return skip();
+        }
+        case Kind::AccessList:
+            if (key_ == "storageKeys")
+                return push(Kind::Strings,
+                            &static_cast<AccessList*>(top.target)->storageKeys);
+            return skip();
+        case Kind::Log:
+            if (key_ == "topics")
+                return push(Kind::Strings,
+                            &static_cast<Log*>(top.target)->topics);
+            return skip();
+        default:
+            return skip();
+    }
+}
+
+ReadStatus parse(std::string_view response, Reader::Kind kind, void* root,
+                 bool bare = false)
+{
+    Reader reader(kind, root, bare);
+    bool complete = nlohmann::json::sax_parse(
+        response.data(), response.data() + response.size(), &reader);
+    return complete ? reader.status() : ReadStatus::Error;
+}
+
+}  // namespace
+
+ReadStatus read(std::string_view response, Block& out)
+{
+    return parse(response, Reader::Kind::Block, &out);
+}
+
+ReadStatus read(std::string_view response, Transaction& out)
+{
+    return parse(response, Reader::Kind::Transaction, &out);
+}
+
+ReadStatus read(std::string_view response, Receipt& out)
+{
+    return parse(response, Reader::Kind::Receipt, &out);
+}
+
+ReadStatus read(std::string_view response, std::vector<Log>& out)
+{
+    return parse(response, Reader::Kind::Logs, &out);
+}
+
+ReadStatus read(std::string_view response, std::vector<Receipt>& out)
+{
+    return parse(response, Reader::Kind::Receipts, &out);
+}
+
+ReadStatus readValue(std::string_view json, Transaction& out)
+{
+    return parse(json, Reader::Kind::Transaction, &out, true);
+}
+
+}  // namespace web3::type::response
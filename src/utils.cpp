@@ -2,12 +2,9 @@
 
 #include <cryptopp/eccrypto.h>
 #include <cryptopp/filters.h>
-#include <cryptopp/hex.h>
 #include <cryptopp/integer.h>
-#include <cryptopp/keccak.h>
 #include <cryptopp/oids.h>
 #include <cryptopp/osrng.h>
-#include <gmpxx.h>
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
 
@@ -17,80 +14,131 @@
 
 #include "types/native.h"
 #include "types/response.h"
+#include "utils/hex.h"
+#include "utils/keccak.h"
 
 namespace web3::utils
 {
 
-type::uint256 toWei(const type::uint256& amount, const std::string& unit)
+namespace
 {
-    auto it = unitMap.find(unit);
-    if (it == unitMap.end())
-        throw std::runtime_error("Unknown unit: " + unit);
 
-    mpz_class factor = 1;
-    mpz_ui_pow_ui(factor.get_mpz_t(), 10, static_cast<int>(it->second));
-    return type::uint256(amount.v * factor);
+// secp256k1 contexts are expensive to create and not safe to share across
+// threads, so each thread keeps one for its lifetime. It is randomized once
+// to blind signing against side channels.
+class Context
+{
+   public:
+    Context()
+        : ctx_(secp256k1_context_create(SECP256K1_CONTEXT_SIGN |
+                                        SECP256K1_CONTEXT_VERIFY))
+    {
+        if (!ctx_)
+            throw std::runtime_error("Failed to create secp256k1 context");
+
+        uint8_t seed[32];
+        CryptoPP::AutoSeededRandomPool rng;
+        rng.GenerateBlock(seed, sizeof(seed));
+        if (!secp256k1_context_randomize(ctx_, seed))
+        {
+            secp256k1_context_destroy(ctx_);
+            throw std::runtime_error("Failed to randomize secp256k1 context");
+        }
+    }
+
+    ~Context()
+    {
+        secp256k1_context_destroy(ctx_);
+    }
+
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    secp256k1_context* get() const
+    {
+        return ctx_;
+    }
+
+   private:
+    secp256k1_context* ctx_;
+};
+
+secp256k1_context* context()
+{
+    thread_local Context ctx;
+    return ctx.get();
 }
 
-type::uint256 fromWei(const type::uint256& amount, const std::string& unit)
+Unit findUnit(const std::string& unit)
 {
     auto it = unitMap.find(unit);
     if (it == unitMap.end())
         throw std::runtime_error("Unknown unit: " + unit);
+    return it->second;
+}
+
+}  // namespace
 
-    mpz_class factor = 1;
-    mpz_ui_pow_ui(factor.get_mpz_t(), 10, static_cast<int>(it->second));
-    return type::uint256(amount.v / factor);
+type::uint256 toWei(const type::uint256& amount, const std::string& unit)
+{
+    return toWei(amount, findUnit(unit));
+}
+
+type::uint256 fromWei(const type::uint256& amount, const std::string& unit)
+{
+    return fromWei(amount, findUnit(unit));
 }
 
 bool isHex(const std::string& hex)
 {
-    std::string hex_n = removeHexPrefix(hex);
-    if (hex_n.empty())
+    auto digits = hex::stripPrefix(hex);
+    if (digits.empty())
         return false;
 
-    return std::all_of(hex_n.begin(), hex_n.end(),
-                       [](unsigned char c) { return std::isxdigit(c); });
+    return hex::validate(digits.data(), digits.size());
 }
 
 std::string ensureHexPrefix(const std::string& hex)
 {
-    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
+    if (hex::hasPrefix(hex))
         return hex;
     return "0x" + hex;
 }
 
 std::string removeHexPrefix(const std::string& hex)
 {
-    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
-        return hex.substr(2);
-    return hex;
+    return std::string(hex::stripPrefix(hex));
 }
 
 type::bytes hexToBytes(const std::string& hex)
 {
-    std::string hex_n = removeHexPrefix(hex);
-    if (hex_n.size() & 1)
-        hex_n = "0" + hex_n;
-
-    type::bytes out(hex_n.size() / 2);
-
-    CryptoPP::StringSource ss(hex_n, true,
-                              new CryptoPP::HexDecoder(new CryptoPP::ArraySink(
-                                  out.data(), out.size())));
+    auto digits = hex::stripPrefix(hex);
+    type::bytes out((digits.size() + 1) / 2);
+    if (out.empty())
+        return out;
+
+    // An odd-length string has an implied leading zero.
+    bool ok = true;
+    uint8_t* dst = out.data();
+    if (digits.size() & 1)
+    {
+        char pair[2] = {'0', digits[0]};
+        ok = hex::decode(pair, 2, dst++);
+        digits.remove_prefix(1);
+    }
+    if (!ok || !hex::decode(digits.data(), digits.size(), dst))
+        throw std::runtime_error("Invalid hex string: " + hex);
 
     return out;
 }
 
 std::string bytesToHex(const type::bytes& bytes)
 {
-    std::string hex;
-    CryptoPP::HexEncoder encoder(new CryptoPP::StringSink(hex), false);
-
-    encoder.Put(bytes.data(), bytes.size());
-    encoder.MessageEnd();
-
-    return "0x" + hex;
+    std::string out(2 + bytes.size() * 2, '\0');
+    out[0] = '0';
+    out[1] = 'x';
+    hex::encode(bytes.data(), bytes.size(), &out[2]);
+    return out;
 }
 
 std::string padLeft(const std::string& hex, size_t length)
@@ -119,30 +167,20 @@ type::bytes concat(const type::bytes& a, const type::bytes& b)
 /**
  * @brief Computes the Keccak-256 hash of the given data.
  *
- * This function takes a vector of bytes as input and returns
- * the Keccak-256 hash of the data as a hexadecimal string
- * prefixed with "0x".
- *
  * @param data A vector of bytes to hash.
- * @return std::string The Keccak-256 hash as a "0x"-prefixed hexadecimal
- * string.
+ * @return type::bytes The 32-byte digest.
  *
- * @note Uses Crypto++ library's Keccak_256 implementation.
+ * @note Use Keccak256 or keccak256Batch from utils/keccak.h to hash into a
+ * fixed array without allocating, or to hash many inputs at once.
  *
  * @example
  * std::vector<uint8_t> myData = {0x01, 0x02, 0x03};
- * std::string hash = keccak256(myData);
- * // hash = "0x..." (64 hex characters)
+ * auto hash = keccak256(myData);
  */
 type::bytes keccak256(const type::bytes& data)
 {
-    CryptoPP::Keccak_256 hash;
-
-    std::vector<uint8_t> digest(32);
-    hash.Update(data.data(), data.size());
-    hash.TruncatedFinal(digest.data(), digest.size());
-
-    return digest;
+    auto digest = Keccak256::hash(data.data(), data.size());
+    return type::bytes(digest.begin(), digest.end());
 }
 
 type::bytes privateKeyToPublicKey(const std::string& privateKey)
@@ -151,22 +189,22 @@ type::bytes privateKeyToPublicKey(const std::string& privateKey)
     if (privKey.size() != 32)
         throw std::runtime_error("Invalid private key length!");
 
-    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+    secp256k1_context* ctx = context();
 
     if (!secp256k1_ec_seckey_verify(ctx, privKey.data()))
-        throw std::runtime_error("Invalide private key length!");
+        throw std::runtime_error("Invalid private key!");
 
     secp256k1_pubkey pubkey;
-    auto res = secp256k1_ec_pubkey_create(ctx, &pubkey, privKey.data());
+    if (!secp256k1_ec_pubkey_create(ctx, &pubkey, privKey.data()))
+        throw std::runtime_error("Invalid private key!");
 
-    type::bytes pub(64);
-    size_t publen = 64;
-    secp256k1_ec_pubkey_serialize(ctx, pub.data(), &publen, &pubkey,
+    // Uncompressed keys are serialized with a 0x04 prefix, which is dropped.
+    uint8_t serialized[65];
+    size_t publen = sizeof(serialized);
+    secp256k1_ec_pubkey_serialize(ctx, serialized, &publen, &pubkey,
                                   SECP256K1_EC_UNCOMPRESSED);
 
-    secp256k1_context_destroy(ctx);
-
-    return pub;
+    return type::bytes(serialized + 1, serialized + 65);
 }
 
 type::address publicKeyToAddress(const type::bytes& publicKey)
@@ -174,11 +212,7 @@ type::address publicKeyToAddress(const type::bytes& publicKey)
     if (publicKey.size() != 64)
         throw std::runtime_error("Invalid public key length.");
 
-    CryptoPP::Keccak_256 hash;
-
-    std::vector<uint8_t> digest(32);
-    hash.Update(publicKey.data(), publicKey.size());
-    hash.TruncatedFinal(digest.data(), digest.size());
+    auto digest = Keccak256::hash(publicKey.data(), publicKey.size());
 
     type::address addr;
     std::copy(digest.end() - 20, digest.end(), addr.bytes.begin());
@@ -190,170 +224,198 @@ type::address privateKeyToAddress(const std::string& privateKey)
     return publicKeyToAddress(privateKeyToPublicKey(privateKey));
 }
 
-type::bytes uint256ToBytes(const type::uint256& value)
+std::string generatePrivateKey()
 {
-    type::bytes bytes(32);
-
-    mpz_export(bytes.data(),        // output buffer
-               nullptr,             // number of limbs written (can ignore)
-               1,                   // most significant word first
-               1,                   // size of each word in bytes
-               1,                   // big-endian within each word
-               0,                   // no nails
-               value.v.get_mpz_t()  // GMP integer
-    );
+    CryptoPP::AutoSeededRandomPool rng;
+    type::bytes key(32);
+    do
+        rng.GenerateBlock(key.data(), key.size());
+    while (!secp256k1_ec_seckey_verify(context(), key.data()));
+    return bytesToHex(key);
+}
 
-    return bytes;
+type::bytes uint256ToBytes(const type::uint256& value)
+{
+    auto bytes = value.toBytes();
+    return type::bytes(bytes.begin(), bytes.end());
 }
 
 namespace sign
 {
 
-Signature signHash(const std::string& privKey, const type::bytes& hash)
+namespace
 {
-    auto privBytes = hexToBytes(privKey);
-    if (privKey.size() != 32)
-        throw std::runtime_error("Invalid private key length!");
-    if (hash.size() != 32)
-        throw std::runtime_error("Invalid private key length!");
 
-    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN |
-                                                      SECP256K1_CONTEXT_VERIFY);
+Signature signRaw(const uint8_t* privKey, const uint8_t* hash)
+{
+    secp256k1_context* ctx = context();
 
     secp256k1_ecdsa_recoverable_signature sig;
-    secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash.data(), privBytes.data(),
-                                     nullptr, nullptr);
+    if (!secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash, privKey, nullptr,
+                                          nullptr))
+        throw std::runtime_error("Invalid private key!");
 
-    type::bytes compact(64);
+    uint8_t compact[64];
     int recid;
-
-    secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, compact.data(),
+    secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, compact,
                                                             &recid, &sig);
 
-    secp256k1_context_destroy(ctx);
-
     Signature res;
-    res.r = bytesToHex(type::bytes(compact.begin(), compact.begin() + 32));
-    res.s = bytesToHex(type::bytes(compact.begin() + 32, compact.end()));
+    res.r = bytesToHex(type::bytes(compact, compact + 32));
+    res.s = bytesToHex(type::bytes(compact + 32, compact + 64));
     res.yParity = recid;
 
     return res;
 }
-}  // namespace sign
 
-namespace rlp
+void checkHash(const type::bytes& hash)
 {
+    if (hash.size() != 32)
+        throw std::runtime_error("Invalid hash length!");
+}
 
-type::bytes encodeUint256(const type::uint256& value)
+type::bytes signPayload(const type::request::Transaction& tx,
+                        const uint8_t* privKey)
 {
-    auto bytes = uint256ToBytes(value);
-    return encodeBytes(bytes);
+    auto payload = rlp::encodeTransaction(tx);
+    auto hash = Keccak256::hash(payload.data(), payload.size());
+    auto sig = signRaw(privKey, hash.data());
+    return rlp::encodeSignedTransaction(tx, sig.yParity, sig.r, sig.s);
 }
 
-type::bytes encodeAddress(const type::address& addr)
+}  // namespace
+
+SecretKey parseSecretKey(const std::string& privKey)
 {
-    return encodeBytes(
-        std::vector<uint8_t>(addr.bytes.begin(), addr.bytes.end()));
+    auto digits = hex::stripPrefix(privKey);
+    SecretKey key;
+    if (digits.size() != 2 * key.size())
+        throw std::runtime_error("Invalid private key length!");
+    if (!hex::decode(digits.data(), digits.size(), key.data()))
+        throw std::runtime_error("Invalid hex string: " + privKey);
+    // Zero and values at or above the curve order are not keys.
+    if (!secp256k1_ec_seckey_verify(context(), key.data()))
+        throw std::runtime_error("Invalid private key!");
+    return key;
 }
 
-type::bytes encodeAccessList(
-    const std::vector<type::response::AccessList>& accessList)
+Signature signHash(const std::string& privKey, const type::bytes& hash)
 {
-    std::vector<type::bytes> entries;
+    return signHash(parseSecretKey(privKey), hash);
+}
 
-    for (auto& access : accessList)
-    {
-        std::vector<type::bytes> storage_keys;
-        for (auto& key : access.storageKeys)
-        {
-            storage_keys.push_back(hexToBytes(key));
-        }
-        type::bytes encoded_storage_keys = encodeList(storage_keys);
+Signature signHash(const SecretKey& key, const type::bytes& hash)
+{
+    checkHash(hash);
+    return signRaw(key.data(), hash.data());
+}
 
-        std::vector<type::bytes> entry = {encodeAddress(access.address),
-                                          encoded_storage_keys};
+std::vector<Signature> signBatch(const std::string& privKey,
+                                 const std::vector<type::bytes>& hashes,
+                                 ThreadPool& pool)
+{
+    auto privBytes = parseSecretKey(privKey);
+    for (const auto& hash : hashes)
+        checkHash(hash);
+
+    std::vector<Signature> out(hashes.size());
+    pool.parallelFor(hashes.size(),
+                     [&](size_t begin, size_t end)
+                     {
+                         for (size_t i = begin; i < end; i++)
+                             out[i] =
+                                 signRaw(privBytes.data(), hashes[i].data());
+                     });
+    return out;
+}
 
-        type::bytes encoded_entry = encodeList(entry);
+std::vector<Signature> signBatch(const std::vector<std::string>& privKeys,
+                                 const std::vector<type::bytes>& hashes,
+                                 ThreadPool& pool)
+{
+    if (privKeys.size() != hashes.size())
+        throw std::runtime_error("Key and hash counts differ!");
 
-        entries.push_back(encoded_entry);
+    std::vector<SecretKey> keys;
+    keys.reserve(privKeys.size());
+    for (size_t i = 0; i < privKeys.size(); i++)
+    {
+        keys.push_back(parseSecretKey(privKeys[i]));
+        checkHash(hashes[i]);
     }
 
-    return encodeList(entries);
+    std::vector<Signature> out(hashes.size());
+    pool.parallelFor(hashes.size(),
+                     [&](size_t begin, size_t end)
+                     {
+                         for (size_t i = begin; i < end; i++)
+                             out[i] = signRaw(keys[i].data(), hashes[i].data());
+                     });
+    return out;
 }
 
-type::bytes encodeAuthorizationList(
-    const std::vector<type::response::AuthorizationList>& authList)
+std::string buildSignedLegacy(const type::request::Transaction& tx,
+                              const Signature& sig)
 {
-    std::vector<type::bytes> entries;
+    if (tx.type != 0)
+        throw std::runtime_error("Not a legacy transaction!");
+    return bytesToHex(
+        rlp::encodeSignedTransaction(tx, sig.yParity, sig.r, sig.s));
+}
 
-    for (auto& auth : authList)
-    {
-        std::vector<type::bytes> entry = {
-            encodeUint256(auth.chainId),     encodeAddress(auth.address),
-            encodeUint256(auth.nonce),       encodeUint256(auth.yParity),
-            encodeBytes(hexToBytes(auth.r)), encodeBytes(hexToBytes(auth.s))};
+std::string buildSignedTyped(const type::request::Transaction& tx,
+                             const Signature& sig)
+{
+    if (tx.type == 0)
+        throw std::runtime_error("Not a typed transaction!");
+    return bytesToHex(
+        rlp::encodeSignedTransaction(tx, sig.yParity, sig.r, sig.s));
+}
 
-        auto encoded_entries = encodeList(entry);
-        entries.push_back(encoded_entries);
-    }
-    return encodeList(entries);
+type::bytes signTransaction(const type::request::Transaction& tx,
+                            const std::string& privKey)
+{
+    return signPayload(tx, parseSecretKey(privKey).data());
 }
 
-type::bytes encodeList(const std::vector<type::bytes>& items)
+type::bytes signTransaction(const type::request::Transaction& tx,
+                            const SecretKey& key)
 {
-    type::bytes encoded;
-    for (const auto& item : items)
-    {
-        auto e = encodeBytes(item);
-        encoded.insert(encoded.end(), e.begin(), e.end());
-    }
+    return signPayload(tx, key.data());
+}
+}  // namespace sign
 
-    size_t len = encoded.size();
-    type::bytes out;
-    if (len <= 55)
-    {
-        out.push_back(0xC0 + len);
-    }
-    else
-    {
-        type::bytes lenBytes = uint256ToBytes(static_cast<uint64_t>(len));
-        auto pos = std::find_if(lenBytes.begin(), lenBytes.end(),
-                                [](uint8_t b) { return b != 0; });
-        lenBytes = type::bytes(pos, lenBytes.end());
-        out.push_back(0xF7 + lenBytes.size());
-        out.insert(out.end(), lenBytes.begin(), lenBytes.end());
-    }
-    out.insert(out.end(), encoded.begin(), encoded.end());
+type::bytes encodeFunctionSelector(const std::string& signature)
+{
+    auto digest = Keccak256::hash(signature);
+    return type::bytes(digest.begin(), digest.begin() + 4);
+}
+
+type::bytes encodeUint(type::uint256& value)
+{
+    return uint256ToBytes(value);
+}
+
+type::bytes encodeAddress(const type::address& address)
+{
+    type::bytes out(32, 0);
+    std::copy(address.bytes.begin(), address.bytes.end(), out.begin() + 12);
     return out;
 }
 
-type::bytes encodeBytes(const type::bytes& bytes)
+type::bytes encodeBool(bool val)
 {
-    size_t len = bytes.size();
-    type::bytes out;
-    if (len == 0)
-        out.push_back(0x80);
-    else if (len == 1 && bytes[0] <= 0x7f)
-        out.push_back(bytes[0]);
-    else if (len <= 55)
-    {
-        out.push_back(0x80 + len);
-        out.insert(out.end(), bytes.begin(), bytes.end());
-    }
-    else
-    {
-        type::bytes lenBytes = uint256ToBytes(static_cast<uint64_t>(len));
-        // remove leading zeros
-        auto pos = std::find_if(lenBytes.begin(), lenBytes.end(),
-                                [](uint8_t b) { return b != 0; });
-        lenBytes = type::bytes(pos, lenBytes.end());
-        out.push_back(0xB7 + lenBytes.size());
-        out.insert(out.end(), lenBytes.begin(), lenBytes.end());
-        out.insert(out.end(), bytes.begin(), bytes.end());
-    }
+    type::bytes out(32, 0);
+    out[31] = val;
     return out;
 }
 
-}  // namespace rlp
+type::bytes encodeBytes(type::bytes bytes)
+{
+    type::bytes out = uint256ToBytes(type::uint256(bytes.size()));
+    out.insert(out.end(), bytes.begin(), bytes.end());
+    out.resize(32 + (bytes.size() + 31) / 32 * 32, 0);
+    return out;
+}
 
 }  // namespace web3::utils
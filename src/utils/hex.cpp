@@ -0,0 +1,266 @@
+#include "utils/hex.h"
+
+#include <array>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define WEB3_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace web3::utils::hex
+{
+
+namespace
+{
+
+constexpr char digits[] = "0123456789abcdef";
+
+// Nibble value of every character, 0xff for non hex digits.
+constexpr std::array<uint8_t, 256> makeDecodeTable()
+{
+    std::array<uint8_t, 256> table{};
+    for (size_t c = 0; c < 256; c++)
+    {
+        if (c >= '0' && c <= '9')
+            table[c] = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            table[c] = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            table[c] = c - 'A' + 10;
+        else
+            table[c] = 0xff;
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> decodeTable = makeDecodeTable();
+
+void encodeScalar(const uint8_t* data, size_t size, char* out)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0xf];
+    }
+}
+
+// Also the tail of the SIMD decoders, which consume even blocks, so an odd
+// size always ends up here.
+bool decodeScalar(const char* text, size_t size, uint8_t* out)
+{
+    if (size % 2 != 0)
+        return false;
+    uint8_t invalid = 0;
+    for (size_t i = 0; i + 1 < size; i += 2)
+    {
+        uint8_t hi = decodeTable[static_cast<uint8_t>(text[i])];
+        uint8_t lo = decodeTable[static_cast<uint8_t>(text[i + 1])];
+        invalid |= hi | lo;
+        out[i / 2] = static_cast<uint8_t>(hi << 4 | lo);
+    }
+    return (invalid & 0xf0) == 0;
+}
+
+bool validateScalar(const char* text, size_t size)
+{
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < size; i++)
+        invalid |= decodeTable[static_cast<uint8_t>(text[i])];
+    return (invalid & 0xf0) == 0;
+}
+
+#ifdef WEB3_HEX_X86
+
+// Converts 16 characters to nibble values. Returns false if any of them is
+// not a hex digit.
+__attribute__((target("ssse3"))) inline bool nibbles(__m128i c, __m128i& v)
+{
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)),
+                             _mm_set1_epi8('a'));
+    __m128i alpha = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    v = _mm_or_si128(_mm_and_si128(digit, d),
+                     _mm_and_si128(alpha, _mm_add_epi8(l, _mm_set1_epi8(10))));
+    return _mm_movemask_epi8(_mm_or_si128(digit, alpha)) == 0xffff;
+}
+
+__attribute__((target("avx2"))) inline bool nibbles(__m256i c, __m256i& v)
+{
+    __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i digit =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)),
+                                _mm256_set1_epi8('a'));
+    __m256i alpha =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    v = _mm256_or_si256(
+        _mm256_and_si256(digit, d),
+        _mm256_and_si256(alpha, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+    return _mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) == -1;
+}
+
+__attribute__((target("ssse3"))) void encodeSSSE3(const uint8_t* data,
+                                                  size_t size, char* out)
+{
+    const __m128i table = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(digits));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    for (; size >= 16; size -= 16, data += 16, out += 32)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i hi =
+            _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(x, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16),
+                         _mm_unpackhi_epi8(hi, lo));
+    }
+    encodeScalar(data, size, out);
+}
+
+__attribute__((target("ssse3"))) bool decodeSSSE3(const char* text,
+                                                  size_t size, uint8_t* out)
+{
+    // Multiplies the high nibble of each pair by 16 and adds the low one.
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    for (; size >= 32; size -= 32, text += 32, out += 16)
+    {
+        __m128i a, b;
+        bool ok = nibbles(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), a);
+        ok &= nibbles(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16)), b);
+        if (!ok)
+            return false;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_packus_epi16(_mm_maddubs_epi16(a, weights),
+                                          _mm_maddubs_epi16(b, weights)));
+    }
+    return decodeScalar(text, size, out);
+}
+
+__attribute__((target("ssse3"))) bool validateSSSE3(const char* text,
+                                                    size_t size)
+{
+    for (; size >= 16; size -= 16, text += 16)
+    {
+        __m128i v;
+        if (!nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)),
+                     v))
+            return false;
+    }
+    return validateScalar(text, size);
+}
+
+__attribute__((target("avx2"))) void encodeAVX2(const uint8_t* data,
+                                                size_t size, char* out)
+{
+    const __m256i table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    for (; size >= 32; size -= 32, data += 32, out += 64)
+    {
+        __m256i x =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i hi = _mm256_shuffle_epi8(
+            table, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, mask));
+        // The unpacks work per 128-bit lane, so put the lanes back in order.
+        __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        __m256i second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    encodeSSSE3(data, size, out);
+}
+
+__attribute__((target("avx2"))) bool decodeAVX2(const char* text, size_t size,
+                                                uint8_t* out)
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    for (; size >= 64; size -= 64, text += 64, out += 32)
+    {
+        __m256i a, b;
+        bool ok = nibbles(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), a);
+        ok &= nibbles(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 32)),
+            b);
+        if (!ok)
+            return false;
+        __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                                             _mm256_maddubs_epi16(b, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                            _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    return decodeSSSE3(text, size, out);
+}
+
+__attribute__((target("avx2"))) bool validateAVX2(const char* text,
+                                                  size_t size)
+{
+    for (; size >= 32; size -= 32, text += 32)
+    {
+        __m256i v;
+        if (!nibbles(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), v))
+            return false;
+    }
+    return validateSSSE3(text, size);
+}
+
+#endif  // WEB3_HEX_X86
+
+struct Kernels
+{
+    void (*encode)(const uint8_t*, size_t, char*);
+    bool (*decode)(const char*, size_t, uint8_t*);
+    bool (*validate)(const char*, size_t);
+    const char* name;
+};
+
+Kernels select()
+{
+#ifdef WEB3_HEX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return {encodeAVX2, decodeAVX2, validateAVX2, "avx2"};
+    if (__builtin_cpu_supports("ssse3"))
+        return {encodeSSSE3, decodeSSSE3, validateSSSE3, "ssse3"};
+#endif
+    return {encodeScalar, decodeScalar, validateScalar, "scalar"};
+}
+
+const Kernels& kernels()
+{
+    static const Kernels selected = select();
+    return selected;
+}
+
+}  // namespace
+
+void encode(const uint8_t* data, size_t size, char* out)
+{
+    kernels().encode(data, size, out);
+}
+
+bool decode(const char* text, size_t size, uint8_t* out)
+{
+    return kernels().decode(text, size, out);
+}
+
+bool validate(const char* text, size_t size)
+{
+    return kernels().validate(text, size);
+}
+
+const char* implementation()
+{
+    return kernels().name;
+}
+
+}  // namespace web3::utils::hex
@@ -0,0 +1,311 @@
+#include "utils/keccak.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define WEB3_KECCAK_X86 1
+#endif
+
+namespace web3::utils
+{
+
+namespace
+{
+
+constexpr size_t rate = 136;
+
+constexpr uint64_t roundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// Rotation offsets and lane order of the combined rho and pi steps.
+constexpr int rotations[24] = {1,  3,  6,  10, 15, 21, 28, 36,
+                               45, 55, 2,  14, 27, 41, 56, 8,
+                               25, 43, 62, 18, 39, 61, 20, 44};
+constexpr int piLanes[24] = {10, 7,  11, 17, 18, 3, 5,  16, 8,  21, 24, 4,
+                             15, 23, 19, 13, 12, 2, 20, 14, 22, 9,  6,  1};
+
+inline uint64_t load64(const uint8_t* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+inline void store64(uint8_t* p, uint64_t v)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    std::memcpy(p, &v, 8);
+}
+
+// Keccak-f[1600] over any lane type supporting ^ & ~ << >>: uint64_t for a
+// single state, or a GCC vector of uint64_t for several states side by side.
+// Always inlined so vector code is generated for the caller's target.
+template <typename V>
+__attribute__((always_inline)) inline void permute(V* state)
+{
+    // Work on a local copy so the lanes can live in registers.
+    V s[25];
+    std::memcpy(s, state, sizeof(s));
+    for (int round = 0; round < 24; round++)
+    {
+        V c[5];
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; x++)
+            c[x] = s[x] ^ s[x + 5] ^ s[x + 10] ^ s[x + 15] ^ s[x + 20];
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; x++)
+        {
+            V r = c[(x + 1) % 5];
+            V d = c[(x + 4) % 5] ^ ((r << 1) | (r >> 63));
+#pragma GCC unroll 5
+            for (int y = 0; y < 25; y += 5)
+                s[y + x] ^= d;
+        }
+
+        V t = s[1];
+#pragma GCC unroll 24
+        for (int i = 0; i < 24; i++)
+        {
+            int n = rotations[i];
+            V next = s[piLanes[i]];
+            s[piLanes[i]] = (t << n) | (t >> (64 - n));
+            t = next;
+        }
+
+#pragma GCC unroll 5
+        for (int y = 0; y < 25; y += 5)
+        {
+            V b[5];
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; x++)
+                b[x] = s[y + x];
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; x++)
+                s[y + x] = b[x] ^ (~b[(x + 1) % 5] & b[(x + 2) % 5]);
+        }
+
+        s[0] ^= roundConstants[round];
+    }
+    std::memcpy(state, s, sizeof(s));
+}
+
+void absorb(uint64_t* state, const uint8_t* block)
+{
+    for (size_t j = 0; j < rate / 8; j++)
+        state[j] ^= load64(block + 8 * j);
+    permute(state);
+}
+
+size_t blockCount(size_t size)
+{
+    // Padding always takes at least one byte.
+    return size / rate + 1;
+}
+
+// Hashes inputs idx[0..n) of equal block count, W at a time in the lanes of
+// V. Unused lanes repeat the first input and are discarded.
+template <typename V, size_t W>
+__attribute__((always_inline)) inline void hashLanes(
+    const uint8_t* const* data, const size_t* sizes, const size_t* idx,
+    size_t n, Hash256* out)
+{
+    size_t blocks = blockCount(sizes[idx[0]]);
+    const uint8_t* msg[W];
+    uint8_t last[W][rate];
+    for (size_t k = 0; k < W; k++)
+    {
+        size_t i = idx[k < n ? k : 0];
+        msg[k] = data[i];
+        size_t tail = sizes[i] - (blocks - 1) * rate;
+        std::memset(last[k], 0, rate);
+        if (tail)
+            std::memcpy(last[k], data[i] + (blocks - 1) * rate, tail);
+        last[k][tail] ^= 0x01;
+        last[k][rate - 1] ^= 0x80;
+    }
+
+    V s[25] = {};
+    for (size_t b = 0; b < blocks; b++)
+    {
+        const uint8_t* block[W];
+        for (size_t k = 0; k < W; k++)
+            block[k] = b + 1 == blocks ? last[k] : msg[k] + b * rate;
+        for (size_t j = 0; j < rate / 8; j++)
+        {
+            uint64_t lanes[W];
+            for (size_t k = 0; k < W; k++)
+                lanes[k] = load64(block[k] + 8 * j);
+            V v;
+            std::memcpy(&v, lanes, sizeof(v));
+            s[j] ^= v;
+        }
+        permute(s);
+    }
+
+    for (size_t k = 0; k < n; k++)
+        for (size_t j = 0; j < 4; j++)
+            store64(out[idx[k]].data() + 8 * j, s[j][k]);
+}
+
+void hashScalar(const uint8_t* const* data, const size_t* sizes,
+                const size_t* idx, size_t n, Hash256* out)
+{
+    for (size_t k = 0; k < n; k++)
+        out[idx[k]] = Keccak256::hash(data[idx[k]], sizes[idx[k]]);
+}
+
+#ifdef WEB3_KECCAK_X86
+
+typedef uint64_t Lanes4 __attribute__((vector_size(32)));
+typedef uint64_t Lanes8 __attribute__((vector_size(64)));
+
+__attribute__((target("avx2"))) void hashAVX2(const uint8_t* const* data,
+                                              const size_t* sizes,
+                                              const size_t* idx, size_t n,
+                                              Hash256* out)
+{
+    hashLanes<Lanes4, 4>(data, sizes, idx, n, out);
+}
+
+__attribute__((target("avx512f"))) void hashAVX512(
+    const uint8_t* const* data, const size_t* sizes, const size_t* idx,
+    size_t n, Hash256* out)
+{
+    hashLanes<Lanes8, 8>(data, sizes, idx, n, out);
+}
+
+#endif  // WEB3_KECCAK_X86
+
+struct Kernel
+{
+    void (*hash)(const uint8_t* const*, const size_t*, const size_t*, size_t,
+                 Hash256*);
+    size_t width;
+};
+
+Kernel select()
+{
+#ifdef WEB3_KECCAK_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {hashAVX512, 8};
+    if (__builtin_cpu_supports("avx2"))
+        return {hashAVX2, 4};
+#endif
+    return {hashScalar, 1};
+}
+
+const Kernel& kernel()
+{
+    static const Kernel selected = select();
+    return selected;
+}
+
+}  // namespace
+
+void Keccak256::reset()
+{
+    std::fill(std::begin(state_), std::end(state_), 0);
+    buffered_ = 0;
+}
+
+Keccak256& Keccak256::update(const uint8_t* data, size_t size)
+{
+    if (buffered_)
+    {
+        size_t n = std::min(size, rate - buffered_);
+        std::memcpy(buffer_ + buffered_, data, n);
+        buffered_ += n;
+        data += n;
+        size -= n;
+        if (buffered_ < rate)
+            return *this;
+        absorb(state_, buffer_);
+        buffered_ = 0;
+    }
+
+    for (; size >= rate; data += rate, size -= rate)
+        absorb(state_, data);
+
+    if (size)
+        std::memcpy(buffer_, data, size);
+    buffered_ = size;
+    return *this;
+}
+
+void Keccak256::finalize(uint8_t* out)
+{
+    std::memset(buffer_ + buffered_, 0, rate - buffered_);
+    buffer_[buffered_] ^= 0x01;
+    buffer_[rate - 1] ^= 0x80;
+    absorb(state_, buffer_);
+
+    for (size_t j = 0; j < 4; j++)
+        store64(out + 8 * j, state_[j]);
+    reset();
+}
+
+void keccak256Batch(const uint8_t* const* data, const size_t* sizes,
+                    size_t count, Hash256* out)
+{
+    const Kernel& k = kernel();
+
+    // Group inputs by block count so every lane of a SIMD pass does the same
+    // number of permutations.
+    std::vector<size_t> idx(count);
+    for (size_t i = 0; i < count; i++)
+        idx[i] = i;
+    if (k.width > 1)
+        std::stable_sort(idx.begin(), idx.end(),
+                         [&](size_t a, size_t b)
+                         {
+                             return blockCount(sizes[a]) <
+                                    blockCount(sizes[b]);
+                         });
+
+    for (size_t begin = 0; begin < count;)
+    {
+        size_t blocks = blockCount(sizes[idx[begin]]);
+        size_t end = begin + 1;
+        while (end < count && end - begin < k.width &&
+               blockCount(sizes[idx[end]]) == blocks)
+            end++;
+
+        // A lone input is cheaper on its own than in a half empty vector.
+        if (end - begin == 1)
+            hashScalar(data, sizes, &idx[begin], 1, out);
+        else
+            k.hash(data, sizes, &idx[begin], end - begin, out);
+        begin = end;
+    }
+}
+
+std::vector<Hash256> keccak256Batch(const std::vector<type::bytes>& inputs)
+{
+    std::vector<const uint8_t*> data(inputs.size());
+    std::vector<size_t> sizes(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        data[i] = inputs[i].data();
+        sizes[i] = inputs[i].size();
+    }
+
+    std::vector<Hash256> out(inputs.size());
+    keccak256Batch(data.data(), sizes.data(), inputs.size(), out.data());
+    return out;
+}
+
+}  // namespace web3::utils
@@ -0,0 +1,723 @@
+#include "utils/rlp.h"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "utils/hex.h"
+
+namespace web3::utils::rlp
+{
+
+void Writer::header(uint8_t base, size_t payload)
+{
+    if (payload <= 55)
+    {
+        *out_++ = static_cast<uint8_t>(base + payload);
+        return;
+    }
+
+    size_t length = headerSize(payload) - 1;
+    *out_++ = static_cast<uint8_t>(base + 55 + length);
+    for (size_t i = length; i-- > 0;)
+        *out_++ = static_cast<uint8_t>(payload >> (8 * i));
+}
+
+void Writer::bytes(const uint8_t* data, size_t size)
+{
+    bool single = size == 1 && data[0] < 0x80;
+    if (!out_)
+    {
+        size_ += single ? 1 : headerSize(size) + size;
+        return;
+    }
+
+    if (!single)
+        header(0x80, size);
+    if (size)
+        std::memcpy(out_, data, size);
+    out_ += size;
+}
+
+void Writer::hex(std::string_view text)
+{
+    auto digits = hex::stripPrefix(text);
+    size_t size = (digits.size() + 1) / 2;
+
+    // The first byte is needed up front to tell whether a single byte
+    // stands for itself. An odd-length string has an implied leading zero.
+    size_t used = digits.size() % 2 ? 1 : 2;
+    char pair[2] = {'0', '0'};
+    if (used == 1)
+        pair[1] = digits[0];
+    else if (size)
+        pair[0] = digits[0], pair[1] = digits[1];
+
+    uint8_t first;
+    if (!hex::decode(pair, 2, &first))
+        throw std::runtime_error("Invalid hex string: " + std::string(text));
+
+    if (size <= 1)
+    {
+        bytes(&first, size);
+        return;
+    }
+    if (!out_)
+    {
+        size_ += headerSize(size) + size;
+        return;
+    }
+
+    header(0x80, size);
+    *out_++ = first;
+    if (!hex::decode(digits.data() + used, digits.size() - used, out_))
+        throw std::runtime_error("Invalid hex string: " + std::string(text));
+    out_ += size - 1;
+}
+
+void Writer::uint(const type::uint256& value)
+{
+    auto be = value.toBytes();
+    size_t size = value.byteLength();
+    bytes(be.data() + be.size() - size, size);
+}
+
+void Writer::raw(const uint8_t* data, size_t size)
+{
+    if (out_)
+    {
+        if (size)
+            std::memcpy(out_, data, size);
+        out_ += size;
+    }
+    else
+        size_ += size;
+}
+
+type::bytes encodeBytes(const type::bytes& bytes)
+{
+    return encode([&](Writer& w) { w.bytes(bytes); });
+}
+
+type::bytes encodeUint256(const type::uint256& value)
+{
+    return encode([&](Writer& w) { w.uint(value); });
+}
+
+type::bytes encodeAddress(const type::address& addr)
+{
+    return encode([&](Writer& w) { w.address(addr); });
+}
+
+type::bytes encodeList(const std::vector<type::bytes>& items)
+{
+    return encode(
+        [&](Writer& w)
+        {
+            w.list(
+                [&](Writer& w)
+                {
+                    for (const auto& item : items)
+                        w.raw(item.data(), item.size());
+                });
+        });
+}
+
+void writeAccessList(Writer& w,
+                     const std::vector<type::response::AccessList>& list)
+{
+    w.list(
+        [&](Writer& w)
+        {
+            for (const auto& access : list)
+                w.list(
+                    [&](Writer& w)
+                    {
+                        w.address(access.address);
+                        w.list(
+                            [&](Writer& w)
+                            {
+                                for (const auto& key : access.storageKeys)
+                                    w.hex(key);
+                            });
+                    });
+        });
+}
+
+void writeAuthorizationList(
+    Writer& w, const std::vector<type::response::AuthorizationList>& list)
+{
+    w.list(
+        [&](Writer& w)
+        {
+            for (const auto& auth : list)
+                w.list(
+                    [&](Writer& w)
+                    {
+                        w.uint(auth.chainId);
+                        w.address(auth.address);
+                        w.uint(auth.nonce);
+                        w.uint(auth.yParity);
+                        w.uint(type::uint256(auth.r, 16));
+                        w.uint(type::uint256(auth.s, 16));
+                    });
+        });
+}
+
+type::bytes encodeAccessList(
+    const std::vector<type::response::AccessList>& accessList)
+{
+    return encode([&](Writer& w) { writeAccessList(w, accessList); });
+}
+
+type::bytes encodeAuthorizationList(
+    const std::vector<type::response::AuthorizationList>& authList)
+{
+    return encode([&](Writer& w) { writeAuthorizationList(w, authList); });
+}
+
+namespace
+{
+
+using type::request::Transaction;
+
+void writeDestination(Writer& w, const type::address& to)
+{
+    if (to == type::address())
+        w.bytes(nullptr, 0);
+    else
+        w.address(to);
+}
+
+// Fields of the legacy transaction up to and including the data.
+void writeLegacyFields(Writer& w, const Transaction& tx)
+{
+    w.uint(tx.nonce);
+    w.uint(tx.gasPrice);
+    w.uint(tx.gas);
+    writeDestination(w, tx.to);
+    w.uint(tx.value);
+    w.bytes(tx.input);
+}
+
+// Unsigned fields of the typed (EIP-2718) transaction of the given type.
+void writeTypedFields(Writer& w, const Transaction& tx, uint8_t type)
+{
+    w.uint(tx.chainId);
+    w.uint(tx.nonce);
+    if (type == 1)
+    {
+        w.uint(tx.gasPrice);
+    }
+    else
+    {
+        w.uint(tx.maxPriorityFeePerGas);
+        w.uint(tx.maxFeePerGas);
+    }
+    w.uint(tx.gas);
+    writeDestination(w, tx.to);
+    w.uint(tx.value);
+    w.bytes(tx.input);
+    writeAccessList(w, tx.accessList);
+
+    if (type == 3)
+    {
+        w.uint(tx.maxFeePerBlobGas);
+        w.list(
+            [&](Writer& w)
+            {
+                for (const auto& hash : tx.blobVersionedHashes)
+                {
+                    auto be = hash.toBytes();
+                    w.bytes(be.data(), be.size());
+                }
+            });
+    }
+    else if (type == 4)
+    {
+        writeAuthorizationList(w, tx.authorizationList);
+    }
+}
+
+type::bytes encodeTyped(const Transaction& tx, uint8_t type)
+{
+    return encode(
+        [&](Writer& w)
+        {
+            w.raw(&type, 1);
+            w.list([&](Writer& w) { writeTypedFields(w, tx, type); });
+        });
+}
+
+}  // namespace
+
+type::bytes encodeLegacyTransaction(const Transaction& tx)
+{
+    // EIP-155 replay protection commits to the chain id, unless there is
+    // none.
+    return encode(
+        [&](Writer& w)
+        {
+            w.list(
+                [&](Writer& w)
+                {
+                    writeLegacyFields(w, tx);
+                    if (!tx.chainId.isZero())
+                    {
+                        w.uint(tx.chainId);
+                        w.uint(0);
+                        w.uint(0);
+                    }
+                });
+        });
+}
+
+type::bytes encodeEIP2930Transaction(const Transaction& tx)
+{
+    return encodeTyped(tx, 1);
+}
+
+type::bytes encodeEIP1559Transaction(const Transaction& tx)
+{
+    return encodeTyped(tx, 2);
+}
+
+type::bytes encodeEIP4844Transaction(const Transaction& tx)
+{
+    return encodeTyped(tx, 3);
+}
+
+type::bytes encodeEIP7702Transaction(const Transaction& tx)
+{
+    return encodeTyped(tx, 4);
+}
+
+type::bytes encodeTransaction(const Transaction& tx)
+{
+    switch (tx.type)
+    {
+        case 0:
+            return encodeLegacyTransaction(tx);
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+            return encodeTyped(tx, tx.type);
+        default:
+            throw std::runtime_error("Unsupported transaction type: " +
+                                     std::to_string(tx.type));
+    }
+}
+
+type::bytes encodeSignedTransaction(const Transaction& tx, uint8_t yParity,
+                                    std::string_view r, std::string_view s)
+{
+    auto rValue = type::uint256::parse(hex::stripPrefix(r), 16);
+    auto sValue = type::uint256::parse(hex::stripPrefix(s), 16);
+
+    if (tx.type == 0)
+    {
+        type::uint256 v =
+            tx.chainId.isZero()
+                ? type::uint256(27 + yParity)
+                : tx.chainId * type::uint256(2) + type::uint256(35 + yParity);
+        return encode(
+            [&](Writer& w)
+            {
+                w.list(
+                    [&](Writer& w)
+                    {
+                        writeLegacyFields(w, tx);
+                        w.uint(v);
+                        w.uint(rValue);
+                        w.uint(sValue);
+                    });
+            });
+    }
+
+    if (tx.type > 4)
+        throw std::runtime_error("Unsupported transaction type: " +
+                                 std::to_string(tx.type));
+
+    return encode(
+        [&](Writer& w)
+        {
+            w.raw(&tx.type, 1);
+            w.list(
+                [&](Writer& w)
+                {
+                    writeTypedFields(w, tx, tx.type);
+                    w.uint(yParity);
+                    w.uint(rValue);
+                    w.uint(sValue);
+                });
+        });
+}
+
+Item Item::parse(const uint8_t* data, size_t size, bool trailing)
+{
+    if (!size)
+        throw std::runtime_error("RLP: empty input");
+
+    Item item;
+    uint8_t prefix = data[0];
+    if (prefix < 0x80)
+    {
+        if (!trailing && size != 1)
+            throw std::runtime_error("RLP: trailing bytes");
+        item.payload_ = data;
+        item.size_ = 1;
+        return item;
+    }
+
+    item.list_ = prefix >= 0xc0;
+    uint8_t base = item.list_ ? 0xc0 : 0x80;
+    size_t length = prefix - base;
+    item.header_ = 1;
+    if (length > 55)
+    {
+        size_t bytes = length - 55;
+        if (bytes > sizeof(size_t) || size < 1 + bytes)
+            throw std::runtime_error("RLP: truncated length");
+        if (data[1] == 0)
+            throw std::runtime_error("RLP: non-canonical length");
+        length = 0;
+        for (size_t i = 1; i <= bytes; i++)
+            length = length << 8 | data[i];
+        if (length <= 55)
+            throw std::runtime_error("RLP: non-canonical length");
+        item.header_ += bytes;
+    }
+
+    if (length > size - item.header_)
+        throw std::runtime_error("RLP: truncated item");
+    if (!trailing && length != size - item.header_)
+        throw std::runtime_error("RLP: trailing bytes");
+
+    item.payload_ = data + item.header_;
+    item.size_ = length;
+    if (!item.list_ && length == 1 && item.payload_[0] < 0x80)
+        throw std::runtime_error("RLP: non-canonical single byte");
+    return item;
+}
+
+size_t Item::count() const
+{
+    size_t n = 0;
+    for (auto it = begin(); it != end(); ++it)
+        n++;
+    return n;
+}
+
+Item Item::operator[](size_t index) const
+{
+    for (auto it = begin(); it != end(); ++it)
+        if (!index--)
+            return *it;
+    throw std::out_of_range("RLP: list index out of range");
+}
+
+void Item::expectString() const
+{
+    if (list_)
+        throw std::runtime_error("RLP: expected a string, got a list");
+}
+
+type::bytes Item::bytes() const
+{
+    expectString();
+    return type::bytes(payload_, payload_ + size_);
+}
+
+std::string Item::toHex() const
+{
+    expectString();
+    std::string out(2 + 2 * size_, '0');
+    out[1] = 'x';
+    hex::encode(payload_, size_, &out[2]);
+    return out;
+}
+
+type::uint256 Item::toUint256() const
+{
+    expectString();
+    if (size_ > 32)
+        throw std::runtime_error("RLP: integer wider than 256 bits");
+    if (size_ && payload_[0] == 0)
+        throw std::runtime_error("RLP: integer with leading zeros");
+    return type::uint256::fromBytes(payload_, size_);
+}
+
+uint64_t Item::toU64() const
+{
+    if (size_ > 8)
+        throw std::runtime_error("RLP: integer wider than 64 bits");
+    return toUint256().toU64();
+}
+
+type::address Item::toAddress() const
+{
+    expectString();
+    if (size_ != 20)
+        throw std::runtime_error("RLP: address must be 20 bytes");
+    std::array<uint8_t, 20> bytes;
+    std::memcpy(bytes.data(), payload_, 20);
+    return type::address(bytes);
+}
+
+namespace
+{
+
+Item expectList(const Item& item)
+{
+    if (!item.isList())
+        throw std::runtime_error("RLP: expected a list, got a string");
+    return item;
+}
+
+// Reads the list fields of a transaction in order.
+class FieldReader
+{
+   public:
+    explicit FieldReader(const Item& fields)
+        : it_(expectList(fields).begin()), end_(fields.end())
+    {
+    }
+
+    bool done() const
+    {
+        return it_ == end_;
+    }
+
+    Item next()
+    {
+        if (done())
+            throw std::runtime_error("RLP: transaction has too few fields");
+        Item item = *it_;
+        ++it_;
+        return item;
+    }
+
+    type::uint256 uint()
+    {
+        return next().toUint256();
+    }
+
+    // An empty destination means contract creation.
+    type::address destination()
+    {
+        Item item = next();
+        return item.size() || item.isList() ? item.toAddress()
+                                            : type::address();
+    }
+
+   private:
+    Item::Iterator it_;
+    Item::Iterator end_;
+};
+
+std::vector<type::response::AccessList> readAccessList(const Item& list)
+{
+    std::vector<type::response::AccessList> out;
+    for (Item entry : expectList(list))
+    {
+        FieldReader fields(entry);
+        type::response::AccessList access;
+        access.address = fields.next().toAddress();
+        for (Item key : expectList(fields.next()))
+        {
+            if (key.size() != 32)
+                throw std::runtime_error("RLP: storage key must be 32 bytes");
+            access.storageKeys.push_back(key.toHex());
+        }
+        if (!fields.done())
+            throw std::runtime_error("RLP: malformed access list entry");
+        out.push_back(std::move(access));
+    }
+    return out;
+}
+
+}  // namespace
+
+namespace
+{
+
+std::vector<type::response::AuthorizationList> readAuthorizationList(
+    const Item& list)
+{
+    std::vector<type::response::AuthorizationList> out;
+    for (Item entry : expectList(list))
+    {
+        FieldReader fields(entry);
+        type::response::AuthorizationList auth;
+        auth.chainId = fields.uint();
+        auth.address = fields.next().toAddress();
+        auth.nonce = fields.uint();
+        uint64_t yParity = fields.next().toU64();
+        if (yParity > 1)
+            throw std::runtime_error("RLP: invalid authorization y parity");
+        auth.yParity = static_cast<uint8_t>(yParity);
+        auth.r = fields.uint().toHex();
+        auth.s = fields.uint().toHex();
+        if (!fields.done())
+            throw std::runtime_error("RLP: malformed authorization entry");
+        out.push_back(std::move(auth));
+    }
+    return out;
+}
+
+// Reads the optional trailing yParity, r and s of a typed transaction.
+void readTypedSignature(FieldReader& fields, DecodedTransaction& out)
+{
+    if (fields.done())
+        return;
+    uint64_t yParity = fields.next().toU64();
+    if (yParity > 1)
+        throw std::runtime_error("RLP: invalid y parity");
+    out.isSigned = true;
+    out.yParity = static_cast<uint8_t>(yParity);
+    out.r = fields.uint();
+    out.s = fields.uint();
+    if (!fields.done())
+        throw std::runtime_error("RLP: transaction has too many fields");
+}
+
+// Mirror of writeTypedFields.
+DecodedTransaction decodeTyped(const Item& list, uint8_t type)
+{
+    DecodedTransaction out;
+    Transaction& tx = out.tx;
+    FieldReader fields(list);
+    tx.type = type;
+    tx.chainId = fields.uint();
+    tx.nonce = fields.uint();
+    if (type == 1)
+    {
+        tx.gasPrice = fields.uint();
+    }
+    else
+    {
+        tx.maxPriorityFeePerGas = fields.uint();
+        tx.maxFeePerGas = fields.uint();
+    }
+    tx.gas = fields.uint();
+    tx.to = fields.destination();
+    tx.value = fields.uint();
+    tx.input = fields.next().bytes();
+    tx.accessList = readAccessList(fields.next());
+
+    if (type == 3)
+    {
+        tx.maxFeePerBlobGas = fields.uint();
+        for (Item hash : expectList(fields.next()))
+        {
+            if (hash.isList() || hash.size() != 32)
+                throw std::runtime_error("RLP: blob hash must be 32 bytes");
+            tx.blobVersionedHashes.push_back(
+                type::uint256::fromBytes(hash.data(), hash.size()));
+        }
+    }
+    else if (type == 4)
+    {
+        tx.authorizationList = readAuthorizationList(fields.next());
+    }
+
+    readTypedSignature(fields, out);
+    return out;
+}
+
+}  // namespace
+
+DecodedTransaction decodeLegacyTransaction(const Item& list)
+{
+    DecodedTransaction out;
+    Transaction& tx = out.tx;
+    FieldReader fields(list);
+    tx.nonce = fields.uint();
+    tx.gasPrice = fields.uint();
+    tx.gas = fields.uint();
+    tx.to = fields.destination();
+    tx.value = fields.uint();
+    tx.input = fields.next().bytes();
+    if (fields.done())
+        return out;
+
+    type::uint256 v = fields.uint();
+    type::uint256 r = fields.uint();
+    type::uint256 s = fields.uint();
+    if (!fields.done())
+        throw std::runtime_error("RLP: transaction has too many fields");
+
+    // An EIP-155 signing payload ends in (chainId, 0, 0).
+    if (r.isZero() && s.isZero())
+    {
+        tx.chainId = v;
+        return out;
+    }
+
+    out.isSigned = true;
+    out.r = r;
+    out.s = s;
+    if (v >= type::uint256(35))
+    {
+        v -= type::uint256(35);
+        tx.chainId = v >> 1;
+        out.yParity = static_cast<uint8_t>(v.toU64() & 1);
+    }
+    else if (v == type::uint256(27) || v == type::uint256(28))
+    {
+        out.yParity = static_cast<uint8_t>(v.toU64() - 27);
+    }
+    else
+    {
+        throw std::runtime_error("RLP: invalid legacy signature v");
+    }
+    return out;
+}
+
+DecodedTransaction decodeEIP2930Transaction(const Item& fields)
+{
+    return decodeTyped(fields, 1);
+}
+
+DecodedTransaction decodeEIP1559Transaction(const Item& fields)
+{
+    return decodeTyped(fields, 2);
+}
+
+DecodedTransaction decodeEIP4844Transaction(const Item& fields)
+{
+    return decodeTyped(fields, 3);
+}
+
+DecodedTransaction decodeEIP7702Transaction(const Item& fields)
+{
+    return decodeTyped(fields, 4);
+}
+
+DecodedTransaction decodeTransaction(const uint8_t* data, size_t size)
+{
+    if (!size)
+        throw std::runtime_error("RLP: empty transaction");
+
+    // Legacy transactions are a bare list; typed ones are the type byte
+    // followed by a list (EIP-2718).
+    if (data[0] >= 0xc0)
+        return decodeLegacyTransaction(Item::parse(data, size));
+
+    uint8_t type = data[0];
+    if (type < 1 || type > 4)
+        throw std::runtime_error("Unsupported transaction type: " +
+                                 std::to_string(type));
+    return decodeTyped(Item::parse(data + 1, size - 1), type);
+}
+
+DecodedTransaction decodeTransaction(const Item& item)
+{
+    if (item.isList())
+        return decodeLegacyTransaction(item);
+    return decodeTransaction(item.data(), item.size());
+}
+
+}  // namespace web3::utils::rlp
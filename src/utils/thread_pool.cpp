@@ -0,0 +1,126 @@
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace web3::utils
+{
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++)
+        workers_.emplace_back(&ThreadPool::run, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::run()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, size_t)>& f,
+                             size_t grain)
+{
+    if (count == 0)
+        return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Split into a few ranges per thread so uneven work still balances.
+    size_t chunk = std::max(grain, count / (size() * 4 + 1));
+    size_t chunks = (count + chunk - 1) / chunk;
+
+    // Helpers may start after the caller already returned, so everything
+    // they touch is shared. f is only called for claimed ranges, all of which
+    // complete before parallelFor returns.
+    struct State
+    {
+        const std::function<void(size_t, size_t)>* f;
+        size_t count, chunk, chunks;
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t done = 0;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->f = &f;
+    state->count = count;
+    state->chunk = chunk;
+    state->chunks = chunks;
+
+    auto work = [](const std::shared_ptr<State>& s)
+    {
+        for (size_t i; (i = s->next.fetch_add(1)) < s->chunks;)
+        {
+            std::exception_ptr error;
+            try
+            {
+                size_t begin = i * s->chunk;
+                (*s->f)(begin, std::min(begin + s->chunk, s->count));
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (error && !s->error)
+                s->error = error;
+            if (++s->done == s->chunks)
+                s->cv.notify_all();
+        }
+    };
+
+    size_t helpers = std::min(size(), chunks - 1);
+    for (size_t i = 0; i < helpers; i++)
+        post([state, work] { work(state); });
+    work(state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == state->chunks; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+}  // namespace web3::utils
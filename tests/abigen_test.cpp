@@ -0,0 +1,91 @@
+// Bindings generated from abi/bindings.json at build time, checked against
+// the run time ABI encoder. The parameter names clash with the locals of the
+// generated code, so the header only compiles if abigen renames them.
+
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "bindings.h"
+#include "check.h"
+#include "eth/abi.h"
+
+namespace abi = web3::eth::abi;
+using web3::type::address;
+using web3::type::uint256;
+
+namespace
+{
+
+const address recipient("0x00000000219ab540356cbb839cbe05303d7705fa");
+
+void testFixedCall(const abi::Interface& contract)
+{
+    const abi::Function& f = contract.function("send");
+    CHECK(bindings::send::selector == f.selector);
+
+    bindings::send call;
+    call.out_ = recipient;
+    CHECK(call.encode() == f.encodeCall({recipient}));
+}
+
+void testDynamicCall(const abi::Interface& contract)
+{
+    const abi::Function& f = contract.function("store");
+
+    bindings::store call;
+    call.inputs_ = {1, 2, 3};
+    call.result_ = uint256(42);
+    CHECK(call.encode() == f.encodeCall({call.inputs_, call.result_}));
+
+    auto returned = abi::encode(
+        f.outputs, abi::Value::Array{uint256(7), std::string("seven")});
+    auto result = bindings::store::decode(returned);
+    CHECK(result.outputs_ == uint256(7));
+    CHECK(result.out1 == "seven");
+}
+
+void testFunctionType(const abi::Interface& contract)
+{
+    const abi::Function& f = contract.function("callback");
+    CHECK(std::string(bindings::callback::signature) == "callback(function)");
+    CHECK(bindings::callback::selector == f.selector);
+
+    bindings::callback call;
+    std::fill(call.target.begin(), call.target.end(), 0xab);
+    CHECK(call.encode() == f.encodeCall({abi::bind::toValue(call.target)}));
+}
+
+void testEvent(const abi::Interface& contract)
+{
+    const abi::Event& e = contract.event("Sent");
+    CHECK(bindings::Sent::topic0 == e.topic0);
+
+    abi::RawLog log;
+    log.topics.push_back(e.topic0);
+    log.topics.emplace_back();
+    std::copy(recipient.bytes.begin(), recipient.bytes.end(),
+              log.topics[1].begin() + 12);
+    log.data.assign(32, 0);
+    log.data[31] = 5;
+
+    CHECK(bindings::Sent::matches(log));
+    auto sent = bindings::Sent::decode(log);
+    CHECK(sent.out_ == recipient);
+    CHECK(sent.result_ == uint256(5));
+}
+
+}  // namespace
+
+int main()
+{
+    std::ifstream in(WEB3_TEST_ABI);
+    abi::Interface contract(nlohmann::json::parse(in));
+
+    testFixedCall(contract);
+    testDynamicCall(contract);
+    testFunctionType(contract);
+    testEvent(contract);
+    return web3::test::result();
+}
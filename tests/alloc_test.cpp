@@ -0,0 +1,216 @@
+// Counts heap allocations on the steady-state callMethod path. Once the
+// thread's request and response buffers have grown, a call returning a
+// string result must allocate that string and nothing else.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "check.h"
+#include "core/client.h"
+
+namespace
+{
+
+std::atomic<size_t> allocations{0};
+
+}  // namespace
+
+// The full set of replaceable forms, so every allocation is counted and
+// every pointer goes back to the function that pairs with its allocator.
+namespace
+{
+
+void* allocate(std::size_t size)
+{
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    allocations++;
+    // aligned_alloc wants a multiple of the alignment.
+    auto align = static_cast<std::size_t>(alignment);
+    size = (size + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, size ? size : align))
+        return p;
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+
+using web3::rpc::JsonRPCClient;
+
+// Answers every request with the same text, copied into the caller's
+// buffer.
+class CannedConnector : public web3::rpc::IConnector
+{
+   public:
+    std::string reply;
+    std::string lastRequest;
+
+    std::string send(const std::string& request) override
+    {
+        lastRequest = request;
+        return reply;
+    }
+
+    void sendInto(const std::string& request, std::string& response) override
+    {
+        lastRequest.assign(request);
+        response.assign(reply);
+    }
+};
+
+// More than fits in a std::string inline, so the result itself is one
+// allocation.
+const std::string balance = "0x1bc16d674ec80000";
+const std::string account = "0x00000000219ab540356cbb839cbe05303d7705fa";
+
+std::string getBalance(JsonRPCClient& client)
+{
+    return client.callMethod<std::string>(
+        1, "eth_getBalance", web3::rpc::params(account, "latest"));
+}
+
+void testSteadyState()
+{
+    CannedConnector node;
+    node.reply = R"({"jsonrpc":"2.0","id":1,"result":")" + balance + "\"}";
+    JsonRPCClient client(node);
+
+    // Grow the thread's buffers and the connector's copy of the request.
+    getBalance(client);
+    getBalance(client);
+
+    size_t before = allocations;
+    std::string result = getBalance(client);
+    size_t used = allocations - before;
+
+    CHECK(result == balance);
+    CHECK(used == 1);
+    if (used != 1)
+        std::fprintf(stderr, "callMethod allocated %zu times\n", used);
+}
+
+// The params writer produces the same text as the JSON path.
+void testParamsText()
+{
+    CannedConnector node;
+    node.reply = R"({"jsonrpc":"2.0","id":1,"result":"0x1"})";
+    JsonRPCClient client(node);
+
+    client.callMethod<std::string>(
+        1, "m", nlohmann::json::array({account, true, 7, "a\"b\n"}));
+    std::string viaJson = node.lastRequest;
+    client.callMethod<std::string>(
+        1, "m", web3::rpc::params(account, true, 7, "a\"b\n"));
+    CHECK(node.lastRequest == viaJson);
+
+    client.callMethod<std::string>(1, "m", nlohmann::json::array());
+    viaJson = node.lastRequest;
+    client.callMethod<std::string>(1, "m", web3::rpc::params());
+    CHECK(node.lastRequest == viaJson);
+}
+
+// Responses the string shortcut leaves to the full parse.
+void testFallback()
+{
+    CannedConnector node;
+    JsonRPCClient client(node);
+
+    node.reply = R"({"jsonrpc":"2.0","id":1,"result":"a\"b"})";
+    CHECK(getBalance(client) == "a\"b");
+
+    node.reply = R"({"jsonrpc":"2.0","id":1,"result":{"a":1}})";
+    CHECK(client.callMethod<nlohmann::json>(1, "m", web3::rpc::params())
+              ["a"] == 1);
+
+    node.reply =
+        R"({"jsonrpc":"2.0","id":1,"error":{"code":-32000,"message":"no"}})";
+    CHECK_THROWS(getBalance(client));
+
+    node.reply = R"({"jsonrpc":"2.0","id":1,"result":"0x1"} trailing)";
+    CHECK_THROWS(getBalance(client));
+
+    node.reply = R"({"jsonrpc":"2.0","result":"0x1")";
+    CHECK_THROWS(getBalance(client));
+}
+
+}  // namespace
+
+int main()
+{
+    testSteadyState();
+    testParamsText();
+    testFallback();
+    return web3::test::result();
+}
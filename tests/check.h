@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+
+// Minimal checks for the test executables; unlike assert they stay on in
+// release builds. A test returns web3::test::result() from main.
+namespace web3::test
+{
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+inline int result()
+{
+    if (failures())
+        std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return failures() ? 1 : 0;
+}
+
+}  // namespace web3::test
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__,  \
+                         __LINE__, #condition);                          \
+            web3::test::failures()++;                                    \
+        }                                                                \
+    } while (0)
+
+#define CHECK_THROWS(expression)                                         \
+    do                                                                   \
+    {                                                                    \
+        bool thrown = false;                                             \
+        try                                                              \
+        {                                                                \
+            expression;                                                  \
+        }                                                                \
+        catch (const std::exception&)                                    \
+        {                                                                \
+            thrown = true;                                               \
+        }                                                                \
+        if (!thrown)                                                     \
+        {                                                                \
+            std::fprintf(stderr, "%s:%d: %s did not throw\n", __FILE__,  \
+                         __LINE__, #expression);                         \
+            web3::test::failures()++;                                    \
+        }                                                                \
+    } while (0)
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <cryptopp/base64.h>
+#include <cryptopp/filters.h>
+#include <cryptopp/sha.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace web3::test
+{
+
+/**
+ * @brief Loopback WebSocket JSON-RPC server, serving one client connection
+ * after the other.
+ *
+ * Replies echo the request's id as sent, so connectors rewriting ids are
+ * exercised. Methods:
+ * - echo: result is params[0].
+ * - hold / release: hold is answered only after the next release, which
+ *   is answered first.
+ * - large: result is a string of params[0] characters, sent in fragments
+ *   of params[1] bytes if given.
+ * - ping: the server pings the client and answers true once a pong with
+ *   the same payload came back.
+ * - unreadable: answered with a parse error whose id is null.
+ * - eth_subscribe: result is a fresh subscription id, followed by one
+ *   eth_subscription notification. Its result is a log from the filter's
+ *   address for "logs", otherwise params[1] or, without one, a block.
+ */
+class WebSocketStub
+{
+   public:
+    WebSocketStub()
+    {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t size = sizeof(addr);
+        if (listener_ < 0 ||
+            bind(listener_, reinterpret_cast<sockaddr*>(&addr), size) != 0 ||
+            listen(listener_, 1) != 0 ||
+            getsockname(listener_, reinterpret_cast<sockaddr*>(&addr),
+                        &size) != 0)
+            throw std::runtime_error("WebSocketStub: cannot listen");
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread(&WebSocketStub::run, this);
+    }
+
+    ~WebSocketStub()
+    {
+        shutdown(listener_, SHUT_RDWR);
+        int client = client_;
+        if (client >= 0)
+            shutdown(client, SHUT_RDWR);
+        thread_.join();
+        close(listener_);
+    }
+
+    int port() const
+    {
+        return port_;
+    }
+
+    // Status of the current connection's close frame; zero until it
+    // arrived.
+    int closeStatus() const
+    {
+        return closeStatus_;
+    }
+
+   private:
+    enum Opcode : uint8_t
+    {
+        CONTINUATION = 0x0,
+        TEXT = 0x1,
+        CLOSE = 0x8,
+        PING = 0x9,
+        PONG = 0xA
+    };
+
+    struct Frame
+    {
+        bool fin;
+        uint8_t opcode;
+        std::string payload;
+    };
+
+    void run()
+    {
+        while (true)
+        {
+            int client = accept(listener_, nullptr, nullptr);
+            if (client < 0)
+                return;
+            closeStatus_ = 0;
+            buffer_.clear();
+            client_ = client;
+            try
+            {
+                handshake();
+                serve();
+            }
+            catch (const std::exception&)
+            {
+                // The client went away; the test reports what it missed.
+            }
+            client_ = -1;
+            close(client);
+        }
+    }
+
+    void handshake()
+    {
+        std::string request;
+        while (request.find("\r\n\r\n") == std::string::npos)
+            request += readSome();
+
+        const std::string name = "Sec-WebSocket-Key: ";
+        auto begin = request.find(name);
+        if (begin == std::string::npos)
+            throw std::runtime_error("WebSocketStub: no key");
+        begin += name.size();
+        std::string key =
+            request.substr(begin, request.find("\r\n", begin) - begin) +
+            "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+        uint8_t digest[CryptoPP::SHA1::DIGESTSIZE];
+        CryptoPP::SHA1().CalculateDigest(
+            digest, reinterpret_cast<const uint8_t*>(key.data()), key.size());
+        std::string accept;
+        CryptoPP::StringSource ss(
+            digest, sizeof(digest), true,
+            new CryptoPP::Base64Encoder(new CryptoPP::StringSink(accept),
+                                        false));
+
+        writeAll("HTTP/1.1 101 Switching Protocols\r\n"
+                 "Upgrade: websocket\r\n"
+                 "Connection: Upgrade\r\n"
+                 "Sec-WebSocket-Accept: " +
+                 accept + "\r\n\r\n");
+    }
+
+    void serve()
+    {
+        std::vector<nlohmann::json> held;
+        std::string message;
+        while (true)
+        {
+            Frame frame = readFrame();
+            if (frame.opcode == CLOSE)
+            {
+                sendFrame(CLOSE, frame.payload.substr(0, 2));
+                if (frame.payload.size() >= 2)
+                    closeStatus_ =
+                        static_cast<uint8_t>(frame.payload[0]) << 8 |
+                        static_cast<uint8_t>(frame.payload[1]);
+                return;
+            }
+            if (frame.opcode == PONG)
+            {
+                pong_ = frame.payload;
+                continue;
+            }
+            if (frame.opcode == TEXT)
+                message = frame.payload;
+            else if (frame.opcode == CONTINUATION)
+                message += frame.payload;
+            if (!frame.fin)
+                continue;
+
+            auto request = nlohmann::json::parse(message);
+            const auto& id = request["id"];
+            const auto& params = request["params"];
+            std::string method = request["method"];
+
+            if (method == "echo")
+                reply(id, params[0]);
+            else if (method == "hold")
+                held.push_back(id);
+            else if (method == "release")
+            {
+                reply(id, "released");
+                for (const auto& heldId : held)
+                    reply(heldId, "held");
+                held.clear();
+            }
+            else if (method == "large")
+                reply(id, std::string(params[0].get<size_t>(), 'x'),
+                      params.size() > 1 ? params[1].get<size_t>() : 0);
+            else if (method == "ping")
+            {
+                pong_.clear();
+                sendFrame(PING, "stub-ping");
+                while (pong_.empty())
+                {
+                    Frame pong = readFrame();
+                    if (pong.opcode == PONG)
+                        pong_ = pong.payload;
+                }
+                reply(id, pong_ == "stub-ping");
+            }
+            else if (method == "unreadable")
+                send({{"jsonrpc", "2.0"},
+                      {"id", nullptr},
+                      {"error",
+                       {{"code", -32700}, {"message", "parse error"}}}});
+            else if (method == "eth_subscribe")
+            {
+                std::string subscription =
+                    "0x" + std::to_string(++subscriptions_);
+                reply(id, subscription);
+                send({{"jsonrpc", "2.0"},
+                      {"method", "eth_subscription"},
+                      {"params",
+                       {{"subscription", subscription},
+                        {"result", notification(params)}}}});
+            }
+            else
+                send({{"jsonrpc", "2.0"},
+                      {"id", id},
+                      {"error",
+                       {{"code", -32601}, {"message", "method not found"}}}});
+        }
+    }
+
+    static nlohmann::json notification(const nlohmann::json& params)
+    {
+        if (params[0] == "logs")
+            return {{"address", params[1]["address"]},
+                    {"topics",
+                     nlohmann::json::array({"0x" + std::string(64, 'a')})},
+                    {"data", "0x2a"},
+                    {"blockNumber", "0x10"},
+                    {"logIndex", "0x3"},
+                    {"removed", false}};
+        if (params.size() > 1)
+            return params[1];
+        return {{"number", "0x10"},
+                {"hash", "0x" + std::string(64, 'b')},
+                {"timestamp", "0x6553f100"},
+                {"transactions",
+                 nlohmann::json::array({"0x" + std::string(64, 'c')})}};
+    }
+
+    void reply(const nlohmann::json& id, const nlohmann::json& result,
+               size_t fragment = 0)
+    {
+        send({{"jsonrpc", "2.0"}, {"id", id}, {"result", result}}, fragment);
+    }
+
+    // Sends message as one text frame, or in fragments of the given size.
+    void send(const nlohmann::json& message, size_t fragment = 0)
+    {
+        std::string text = message.dump();
+        if (fragment == 0 || text.size() <= fragment)
+        {
+            sendFrame(TEXT, text);
+            return;
+        }
+        for (size_t pos = 0; pos < text.size(); pos += fragment)
+            sendFrame(pos == 0 ? TEXT : CONTINUATION,
+                      text.substr(pos, fragment),
+                      pos + fragment >= text.size());
+    }
+
+    void sendFrame(uint8_t opcode, const std::string& payload,
+                   bool fin = true)
+    {
+        std::string frame;
+        frame.push_back(static_cast<char>((fin ? 0x80 : 0) | opcode));
+        if (payload.size() < 126)
+            frame.push_back(static_cast<char>(payload.size()));
+        else if (payload.size() <= 0xFFFF)
+        {
+            frame.push_back(126);
+            frame.push_back(static_cast<char>(payload.size() >> 8));
+            frame.push_back(static_cast<char>(payload.size()));
+        }
+        else
+        {
+            frame.push_back(127);
+            for (int shift = 56; shift >= 0; shift -= 8)
+                frame.push_back(
+                    static_cast<char>(uint64_t(payload.size()) >> shift));
+        }
+        writeAll(frame + payload);
+    }
+
+    Frame readFrame()
+    {
+        uint8_t head[2];
+        readExact(reinterpret_cast<char*>(head), 2);
+        Frame frame{(head[0] & 0x80) != 0,
+                    static_cast<uint8_t>(head[0] & 0x0F),
+                    {}};
+        if (!(head[1] & 0x80))
+            throw std::runtime_error("WebSocketStub: unmasked client frame");
+
+        uint64_t size = head[1] & 0x7F;
+        if (size == 126 || size == 127)
+        {
+            uint8_t ext[8];
+            size_t n = size == 126 ? 2 : 8;
+            readExact(reinterpret_cast<char*>(ext), n);
+            size = 0;
+            for (size_t i = 0; i < n; i++)
+                size = (size << 8) | ext[i];
+        }
+        char mask[4];
+        readExact(mask, 4);
+        frame.payload.resize(size);
+        readExact(frame.payload.data(), size);
+        for (size_t i = 0; i < size; i++)
+            frame.payload[i] ^= mask[i & 3];
+        return frame;
+    }
+
+    std::string readSome()
+    {
+        char chunk[4096];
+        ssize_t n = recv(client_, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            throw std::runtime_error("WebSocketStub: connection closed");
+        return std::string(chunk, n);
+    }
+
+    void readExact(char* out, size_t size)
+    {
+        while (buffer_.size() < size)
+            buffer_ += readSome();
+        std::memcpy(out, buffer_.data(), size);
+        buffer_.erase(0, size);
+    }
+
+    void writeAll(const std::string& data)
+    {
+        for (size_t sent = 0; sent < data.size();)
+        {
+            ssize_t n = ::send(client_, data.data() + sent, data.size() - sent,
+                               MSG_NOSIGNAL);
+            if (n <= 0)
+                throw std::runtime_error("WebSocketStub: write failed");
+            sent += n;
+        }
+    }
+
+    int listener_ = -1;
+    std::atomic<int> client_{-1};
+    int port_ = 0;
+    std::string buffer_;
+    std::string pong_;
+    int subscriptions_ = 0;
+    std::atomic<int> closeStatus_{0};
+    std::thread thread_;
+};
+
+}  // namespace web3::test
@@ -0,0 +1,225 @@
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "check.h"
+#include "core/error.h"
+#include "core/websocket.h"
+#include "eth/subscription.h"
+#include "support/websocket_stub.h"
+
+using nlohmann::json;
+using web3::rpc::JsonRPCException;
+using web3::rpc::WebSocketClient;
+
+namespace
+{
+
+json call(WebSocketClient& ws, int id, const std::string& method,
+          const json& params)
+{
+    json request = {
+        {"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", params}};
+    return json::parse(ws.send(request.dump()));
+}
+
+void testRequests(WebSocketClient& ws)
+{
+    json reply = call(ws, 7, "echo", {"hello"});
+    CHECK(reply["id"] == 7);
+    CHECK(reply["result"] == "hello");
+
+    json unknown = call(ws, 8, "nope", json::array());
+    CHECK(unknown["id"] == 8);
+    CHECK(unknown["error"]["code"] == -32601);
+}
+
+// An error the node could not tie to a request comes back with id null; the
+// one request outstanding fails with it instead of waiting forever.
+void testOrphanError(WebSocketClient& ws)
+{
+    int code = 0;
+    try
+    {
+        call(ws, 9, "unreadable", json::array());
+    }
+    catch (const JsonRPCException& e)
+    {
+        code = e.Code();
+    }
+    CHECK(code == -32700);
+    CHECK(call(ws, 10, "echo", {"after"})["result"] == "after");
+}
+
+void testTimeout(WebSocketClient& ws)
+{
+    ws.setTimeout(std::chrono::milliseconds(100));
+    CHECK_THROWS(call(ws, 11, "hold", json::array()));
+    ws.setTimeout(std::chrono::milliseconds::zero());
+    CHECK(call(ws, 12, "echo", {"after"})["result"] == "after");
+}
+
+// Two requests with the same caller id, answered in reverse order.
+void testMultiplexing(WebSocketClient& ws)
+{
+    json request = {{"jsonrpc", "2.0"},
+                    {"id", 1},
+                    {"method", "hold"},
+                    {"params", json::array()}};
+    auto held = ws.sendAsync(request.dump());
+
+    json released = call(ws, 1, "release", json::array());
+    CHECK(released["id"] == 1);
+    CHECK(released["result"] == "released");
+
+    CHECK(held.wait_for(std::chrono::seconds(5)) ==
+          std::future_status::ready);
+    json heldReply = json::parse(held.get());
+    CHECK(heldReply["id"] == 1);
+    CHECK(heldReply["result"] == "held");
+}
+
+// 16- and 64-bit payload lengths, whole and split into continuation
+// frames.
+void testLargeFrames(WebSocketClient& ws)
+{
+    const std::pair<size_t, size_t> cases[] = {
+        {300, 0}, {5000, 1000}, {70000, 0}, {200000, 30000}};
+    for (auto [size, fragment] : cases)
+    {
+        json reply = call(ws, 2, "large", {size, fragment});
+        CHECK(reply["result"].get<std::string>().size() == size);
+    }
+}
+
+void testPing(WebSocketClient& ws)
+{
+    CHECK(call(ws, 3, "ping", json::array())["result"] == true);
+}
+
+void testSubscription(WebSocketClient& ws)
+{
+    std::mutex mutex;
+    std::condition_variable notified;
+    std::string received;
+
+    std::string id = ws.subscribe(R"(["newHeads", {"number": "0x1"}])",
+                                  [&](std::string_view result)
+                                  {
+                                      std::lock_guard<std::mutex> lock(mutex);
+                                      received = result;
+                                      notified.notify_all();
+                                  });
+    CHECK(id.compare(0, 2, "0x") == 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    notified.wait_for(lock, std::chrono::seconds(5),
+                      [&] { return !received.empty(); });
+    CHECK(!received.empty() && json::parse(received)["number"] == "0x1");
+}
+
+// Waits for the first value a subscription handler stores.
+template <typename T>
+struct Received
+{
+    std::mutex mutex;
+    std::condition_variable notified;
+    std::optional<T> value;
+
+    void set(const T& v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = v;
+        notified.notify_all();
+    }
+
+    bool wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return notified.wait_for(lock, std::chrono::seconds(5),
+                                 [&] { return value.has_value(); });
+    }
+};
+
+void testTypedSubscriptions(WebSocketClient& ws)
+{
+    using web3::type::response::Block;
+    using web3::type::response::Log;
+    web3::eth::Subscriptions subscriptions(ws);
+
+    Received<Block> head;
+    std::string headId =
+        subscriptions.newHeads([&](const Block& b) { head.set(b); });
+    CHECK(head.wait());
+    CHECK(head.value->number == "0x10");
+    CHECK(head.value->hash == "0x" + std::string(64, 'b'));
+    CHECK(head.value->timestamp == "0x6553f100");
+    CHECK(head.value->transactionHashes.size() == 1);
+
+    const std::string contract = "0x00000000219ab540356cbb839cbe05303d7705fa";
+    web3::type::request::LogFilter filter;
+    filter.addresses.emplace_back(contract);
+
+    Received<Log> log;
+    std::string logId =
+        subscriptions.logs(filter, [&](const Log& l) { log.set(l); });
+    CHECK(logId != headId);
+    CHECK(log.wait());
+    CHECK(log.value->address == contract);
+    CHECK(log.value->topics.size() == 1 &&
+          log.value->topics[0] == "0x" + std::string(64, 'a'));
+    CHECK(log.value->data == "0x2a");
+    CHECK(log.value->blockNumber == "0x10");
+    CHECK(log.value->logIndex == "0x3");
+    CHECK(!log.value->removed);
+}
+
+// A reply longer than the limit, in one frame or over several, closes the
+// connection with 1009 and fails the request waiting for it.
+void testMessageLimit(web3::test::WebSocketStub& stub, size_t fragment)
+{
+    {
+        WebSocketClient ws("127.0.0.1", stub.port());
+        ws.setMaxMessageSize(1000);
+        json small = call(ws, 1, "large", {900});
+        CHECK(small["result"].get<std::string>().size() == 900);
+        CHECK_THROWS(call(ws, 2, "large", {2000, fragment}));
+        CHECK_THROWS(call(ws, 3, "echo", {"closed"}));
+    }
+    for (int i = 0; i < 500 && stub.closeStatus() == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(stub.closeStatus() == 1009);
+}
+
+}  // namespace
+
+int main()
+{
+    web3::test::WebSocketStub stub;
+    {
+        WebSocketClient ws("127.0.0.1", stub.port());
+        testRequests(ws);
+        testOrphanError(ws);
+        testTimeout(ws);
+        testMultiplexing(ws);
+        testLargeFrames(ws);
+        testPing(ws);
+        testSubscription(ws);
+        testTypedSubscriptions(ws);
+    }
+
+    // The connector's close frame reaches the server before the socket
+    // shuts down.
+    for (int i = 0; i < 500 && stub.closeStatus() == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(stub.closeStatus() == 1000);
+
+    testMessageLimit(stub, 0);
+    testMessageLimit(stub, 800);
+    return web3::test::result();
+}
@@ -0,0 +1,478 @@
+// web3-abigen: generates typed C++ bindings from a contract ABI.
+//
+//   web3-abigen <abi.json> <namespace> [output.h]
+//
+// The input is either the bare ABI array or a build artifact with an "abi"
+// member. Every function becomes a struct holding its arguments, with the
+// selector as a constexpr array and encode()/decode() that never look at
+// the JSON or match names at run time. Every event becomes a struct with
+// its topic0 and a decode() from a RawLog.
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "eth/abi.h"
+
+namespace abi = web3::eth::abi;
+using nlohmann::json;
+
+namespace
+{
+
+const std::set<std::string> keywords = {
+    "alignas",   "alignof",   "and",       "asm",       "auto",
+    "bool",      "break",     "case",      "catch",     "char",
+    "class",     "const",     "constexpr", "continue",  "default",
+    "delete",    "do",        "double",    "else",      "enum",
+    "explicit",  "export",    "extern",    "false",     "float",
+    "for",       "friend",    "goto",      "if",        "inline",
+    "int",       "long",      "mutable",   "namespace", "new",
+    "noexcept",  "not",       "nullptr",   "operator",  "or",
+    "private",   "protected", "public",    "register",  "return",
+    "short",     "signed",    "sizeof",    "static",    "struct",
+    "switch",    "template",  "this",      "throw",     "true",
+    "try",       "typedef",   "typeid",    "typename",  "union",
+    "unsigned",  "using",     "virtual",   "void",      "volatile",
+    "while",     "xor",
+};
+
+// Names the generated structs use for themselves, including the locals of
+// encode() and decode(), which would hide fields of the same name.
+const std::set<std::string> reserved = {
+    "signature", "selector", "topic0",  "Result",  "encode", "decode",
+    "matches",   "toValue",  "fromView", "out",    "inputs", "outputs",
+    "result",
+};
+
+std::string identifier(const std::string& name)
+{
+    std::string out;
+    for (char c : name)
+        out += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    if (out.empty() || std::isdigit(static_cast<unsigned char>(out[0])))
+        out = "_" + out;
+    if (keywords.count(out))
+        out += '_';
+    return out;
+}
+
+// Field names for a parameter list; unnamed ones become <prefix><index>.
+std::vector<std::string> fieldNames(const json& params,
+                                    const std::string& prefix)
+{
+    std::vector<std::string> out;
+    std::set<std::string> used;
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        std::string name = params[i].value("name", "");
+        name = name.empty() ? prefix + std::to_string(i) : identifier(name);
+        if (reserved.count(name))
+            name += '_';
+        while (used.count(name))
+            name += '_';
+        used.insert(name);
+        out.push_back(name);
+    }
+    return out;
+}
+
+std::string byteList(const uint8_t* data, size_t size)
+{
+    std::string out;
+    char buf[8];
+    for (size_t i = 0; i < size; i++)
+    {
+        std::snprintf(buf, sizeof(buf), "%s0x%02x", i ? ", " : "", data[i]);
+        out += buf;
+    }
+    return out;
+}
+
+// True for types that fill exactly one head word.
+bool isWord(const abi::Type& type)
+{
+    switch (type.kind)
+    {
+        case abi::Kind::Uint:
+        case abi::Kind::Int:
+        case abi::Kind::Address:
+        case abi::Kind::Bool:
+        case abi::Kind::FixedBytes:
+            return true;
+        default:
+            return false;
+    }
+}
+
+class Generator
+{
+   public:
+    explicit Generator(const std::string& ns) : ns_(ns)
+    {
+    }
+
+    void function(const json& item);
+    void event(const json& item);
+
+    std::string header() const;
+
+   private:
+    std::string cppType(const abi::Type& type, const json& param);
+    std::string tupleStruct(const abi::Type& type, const json& param);
+    void fields(std::ostream& out, const abi::Type& type, const json& params,
+                const std::vector<std::string>& names,
+                const std::string& indent);
+
+    std::string ns_;
+    // Tuple structs, in an order where members come before their users.
+    std::vector<std::string> structs_;
+    // Tuple struct name to its canonical type, to share identical tuples.
+    std::map<std::string, std::string> tuples_;
+    std::vector<std::string> bindings_;
+    // Every struct name handed out so far.
+    std::set<std::string> used_;
+};
+
+std::string Generator::cppType(const abi::Type& type, const json& param)
+{
+    switch (type.kind)
+    {
+        case abi::Kind::Uint:
+            return type.size <= 64 ? "uint64_t" : "web3::type::uint256";
+        case abi::Kind::Int:
+            // Wider signed integers are carried in two's complement.
+            return type.size <= 64 ? "int64_t" : "web3::type::uint256";
+        case abi::Kind::Address:
+            return "web3::type::address";
+        case abi::Kind::Bool:
+            return "bool";
+        case abi::Kind::FixedBytes:
+            return "std::array<uint8_t, " + std::to_string(type.size) + ">";
+        case abi::Kind::Bytes:
+            return "web3::type::bytes";
+        case abi::Kind::String:
+            return "std::string";
+        case abi::Kind::Array:
+            return "std::vector<" + cppType(type.components[0], param) + ">";
+        case abi::Kind::FixedArray:
+            return "std::array<" + cppType(type.components[0], param) + ", " +
+                   std::to_string(type.size) + ">";
+        case abi::Kind::Tuple:
+            return tupleStruct(type, param);
+    }
+    return "";
+}
+
+// Emits the struct for a tuple parameter, named after its Solidity struct
+// where the ABI records one, and returns the name.
+std::string Generator::tupleStruct(const abi::Type& type, const json& param)
+{
+    std::string name = param.value("internalType", "");
+    if (name.compare(0, 7, "struct ") == 0)
+    {
+        name = name.substr(7);
+        name = name.substr(0, name.find('['));
+        name = identifier(name.substr(name.rfind('.') + 1));
+    }
+    else
+        name = "Tuple";
+
+    std::string canonical = type.canonical();
+    std::string base = name;
+    for (size_t i = 1; used_.count(name); i++)
+    {
+        auto it = tuples_.find(name);
+        if (it != tuples_.end() && it->second == canonical)
+            return name;
+        name = base + std::to_string(i);
+    }
+    tuples_.emplace(name, canonical);
+    used_.insert(name);
+
+    const json& params = param.at("components");
+    auto names = fieldNames(params, "field");
+
+    std::ostringstream out;
+    out << "struct " << name << "\n{\n";
+    fields(out, type, params, names, "    ");
+    out << "\n    web3::eth::abi::Value toValue() const\n    {\n"
+        << "        return web3::eth::abi::Value::Array{";
+    for (size_t i = 0; i < names.size(); i++)
+        out << (i ? ", " : "") << "bind::toValue(" << names[i] << ")";
+    out << "};\n    }\n\n"
+        << "    static " << name
+        << " fromView(const web3::eth::abi::View& view)\n    {\n"
+        << "        " << name << " out;\n";
+    for (size_t i = 0; i < names.size(); i++)
+        out << "        bind::fromView(view[" << i << "], out." << names[i]
+            << ");\n";
+    out << "        return out;\n    }\n};\n";
+
+    // Any tuples among the members were emitted by fields() already.
+    structs_.push_back(out.str());
+    return name;
+}
+
+void Generator::fields(std::ostream& out, const abi::Type& type,
+                       const json& params,
+                       const std::vector<std::string>& names,
+                       const std::string& indent)
+{
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        const abi::Type& member = type.components[i];
+        std::string cpp = cppType(member, params[i]);
+        // Scalars and bytesN are zeroed; class types initialise themselves.
+        bool scalar = member.kind == abi::Kind::Bool ||
+                      member.kind == abi::Kind::FixedBytes ||
+                      ((member.kind == abi::Kind::Uint ||
+                        member.kind == abi::Kind::Int) &&
+                       member.size <= 64);
+        out << indent << cpp << " " << names[i] << (scalar ? "{}" : "")
+            << ";\n";
+    }
+}
+
+void Generator::function(const json& item)
+{
+    abi::Function f = abi::Function::fromJson(item);
+    // Overloads are numbered in ABI order: name, name_1, name_2...
+    std::string structName = identifier(f.name);
+    for (size_t i = 1; used_.count(structName); i++)
+        structName = identifier(f.name) + "_" + std::to_string(i);
+    used_.insert(structName);
+
+    json inputs = item.value("inputs", json::array());
+    json outputs = item.value("outputs", json::array());
+    auto inNames = fieldNames(inputs, "arg");
+    auto outNames = fieldNames(outputs, "out");
+
+    std::ostringstream out;
+    out << "// " << f.signature << "\n"
+        << "struct " << structName << "\n{\n"
+        << "    static constexpr const char* signature = \"" << f.signature
+        << "\";\n"
+        << "    static constexpr std::array<uint8_t, 4> selector{"
+        << byteList(f.selector.data(), 4) << "};\n\n";
+    fields(out, f.inputs, inputs, inNames, "    ");
+    if (!inNames.empty())
+        out << "\n";
+
+    out << "    struct Result\n    {\n";
+    fields(out, f.outputs, outputs, outNames, "        ");
+    out << "    };\n\n";
+
+    // Calls taking only one-word arguments have a fixed layout, so their
+    // words are written straight into place.
+    bool fixed = true;
+    // Signed integers wider than int64 are range checked by the encoder.
+    for (const auto& input : f.inputs.components)
+        fixed = fixed && isWord(input) &&
+                !(input.kind == abi::Kind::Int && input.size > 64);
+
+    out << "    web3::type::bytes encode() const\n    {\n";
+    if (fixed)
+    {
+        out << "        web3::type::bytes out(" << 4 + 32 * inNames.size()
+            << ");\n"
+            << "        std::memcpy(out.data(), selector.data(), 4);\n";
+        for (size_t i = 0; i < inNames.size(); i++)
+            out << "        bind::put(out.data() + " << 4 + 32 * i << ", "
+                << inNames[i] << ", " << f.inputs.components[i].size
+                << ");\n";
+        out << "        return out;\n";
+    }
+    else
+    {
+        out << "        static const web3::eth::abi::Type inputs =\n"
+            << "            web3::eth::abi::Type::parse(\""
+            << f.inputs.canonical() << "\");\n"
+            << "        return bind::encodeCall(selector, inputs, {";
+        for (size_t i = 0; i < inNames.size(); i++)
+            out << (i ? ", " : "") << "bind::toValue(" << inNames[i] << ")";
+        out << "});\n";
+    }
+    out << "    }\n\n";
+
+    out << "    static Result decode(const uint8_t* data, size_t size)\n"
+        << "    {\n";
+    if (outNames.empty())
+        out << "        (void)data;\n        (void)size;\n";
+    else
+        out << "        static const web3::eth::abi::Type outputs =\n"
+            << "            web3::eth::abi::Type::parse(\""
+            << f.outputs.canonical() << "\");\n"
+            << "        web3::eth::abi::View view(outputs, data, size);\n";
+    out << "        Result result;\n";
+    for (size_t i = 0; i < outNames.size(); i++)
+        out << "        bind::fromView(view[" << i << "], result."
+            << outNames[i] << ");\n";
+    out << "        return result;\n    }\n\n"
+        << "    static Result decode(const web3::type::bytes& data)\n"
+        << "    {\n"
+        << "        return decode(data.data(), data.size());\n"
+        << "    }\n};\n";
+    bindings_.push_back(out.str());
+}
+
+void Generator::event(const json& item)
+{
+    abi::Event e = abi::Event::fromJson(item);
+    // Events usually differ from functions only in case; on a clash the
+    // event takes an Event suffix.
+    std::string structName = identifier(e.name);
+    if (used_.count(structName))
+        structName += "Event";
+    for (size_t i = 1; used_.count(structName); i++)
+        structName = identifier(e.name) + "Event" + std::to_string(i);
+    used_.insert(structName);
+
+    json inputs = item.value("inputs", json::array());
+    auto names = fieldNames(inputs, "arg");
+
+    // Indexed inputs that are not one word are only stored as their hash.
+    abi::Type hashed = abi::Type::elementary(abi::Kind::FixedBytes, 32);
+    std::vector<abi::Type> topicTypes;
+    std::vector<abi::Type> fieldTypes;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        const abi::Type& input = e.inputs.components[i];
+        bool byHash = e.indexed[i] && !isWord(input);
+        fieldTypes.push_back(byHash ? hashed : input);
+        if (e.indexed[i])
+            topicTypes.push_back(byHash ? hashed : input);
+    }
+    abi::Type topics = abi::Type::tuple(topicTypes);
+    size_t first = e.anonymous ? 0 : 1;
+    size_t topicCount = first + topicTypes.size();
+
+    std::ostringstream out;
+    out << "// " << (e.anonymous ? "anonymous " : "") << e.signature << "\n"
+        << "struct " << structName << "\n{\n"
+        << "    static constexpr const char* signature = \"" << e.signature
+        << "\";\n"
+        << "    static constexpr std::array<uint8_t, 32> topic0{";
+    for (size_t i = 0; i < 32; i += 8)
+        out << (i ? ",\n        " : "\n        ")
+            << byteList(e.topic0.data() + i, 8);
+    out << "};\n\n";
+    fields(out, abi::Type::tuple(fieldTypes), inputs, names, "    ");
+    if (!names.empty())
+        out << "\n";
+
+    out << "    static bool matches(const web3::eth::abi::RawLog& log)\n"
+        << "    {\n";
+    if (e.anonymous)
+        out << "        return log.topics.size() == " << topicCount << ";\n";
+    else
+        out << "        return log.topics.size() == " << topicCount
+            << " &&\n"
+            << "               std::memcmp(log.topics[0].data(), "
+               "topic0.data(), 32) == 0;\n";
+    out << "    }\n\n";
+
+    out << "    // Throws std::runtime_error unless matches(log).\n"
+        << "    static " << structName
+        << " decode(const web3::eth::abi::RawLog& log)\n    {\n"
+        << "        if (!matches(log))\n"
+        << "            throw std::runtime_error(\"" << e.name
+        << ": log is not this event\");\n";
+    if (!topicTypes.empty())
+        out << "        static const web3::eth::abi::Type topics =\n"
+            << "            web3::eth::abi::Type::parse(\""
+            << topics.canonical() << "\");\n"
+            << "        web3::eth::abi::View indexed(topics, log.topics["
+            << first << "].data(), " << 32 * topicTypes.size() << ");\n";
+    if (!e.data.components.empty())
+        out << "        static const web3::eth::abi::Type data =\n"
+            << "            web3::eth::abi::Type::parse(\""
+            << e.data.canonical() << "\");\n"
+            << "        web3::eth::abi::View values(data, log.data.data(), "
+               "log.data.size());\n";
+    out << "        " << structName << " out;\n";
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        size_t position = e.positions[i] - (e.indexed[i] ? first : 0);
+        out << "        bind::fromView("
+            << (e.indexed[i] ? "indexed" : "values") << "[" << position
+            << "], out." << names[i] << ");\n";
+    }
+    out << "        return out;\n    }\n};\n";
+    bindings_.push_back(out.str());
+}
+
+std::string Generator::header() const
+{
+    std::ostringstream out;
+    out << "// Generated by web3-abigen. Do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include <array>\n#include <cstdint>\n#include <cstring>\n"
+        << "#include <stdexcept>\n#include <string>\n#include <vector>\n\n"
+        << "#include \"eth/abi_bind.h\"\n\n"
+        << "namespace " << ns_ << "\n{\n\n"
+        << "namespace bind = web3::eth::abi::bind;\n";
+    for (const auto& s : structs_)
+        out << "\n" << s;
+    for (const auto& s : bindings_)
+        out << "\n" << s;
+    out << "\n}  // namespace " << ns_ << "\n";
+    return out.str();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " <abi.json> <namespace> [output.h]\n";
+        return 2;
+    }
+
+    try
+    {
+        std::ifstream in(argv[1]);
+        if (!in)
+            throw std::runtime_error(std::string("cannot open ") + argv[1]);
+        json abiJson = json::parse(in);
+        if (abiJson.is_object())
+            abiJson = abiJson.at("abi");
+
+        Generator gen(argv[2]);
+        for (const auto& item : abiJson)
+            if (item.value("type", "function") == "function")
+                gen.function(item);
+        for (const auto& item : abiJson)
+            if (item.value("type", "") == "event")
+                gen.event(item);
+
+        std::string header = gen.header();
+        if (argc == 4)
+        {
+            std::ofstream file(argv[3]);
+            file << header;
+            if (!file)
+                throw std::runtime_error(std::string("cannot write ") +
+                                         argv[3]);
+        }
+        else
+            std::cout << header;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}